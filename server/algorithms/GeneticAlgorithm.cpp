@@ -3,14 +3,42 @@
     INPUT
         argv[1]  - h (min. difference between neighbors)
         argv[2]  - k (min. difference between second order neighbors)
-        argv[3]  - file
+        argv[3]  - file (text input file or binary graph file)
         argv[4]  - max. label value
         argv[5]  - populations count
         argv[6]  - population size
         argv[7]  - mutation chance
         argv[8]  - elites count
         argv[9]  - max. generations
-        argv[10] - max. running time
+        argv[10] - max. running time (seconds, with millisecond resolution)
+
+        --seed n           - seed of the random number generators (default: random)
+        --cache dir        - directory of the preprocessed graphs (default: no cache)
+        --crossover name   - crossover operator (default: uniform)
+                             uniform:   every gene from a random parent, weighted by fitness
+                             block:     a breadth first block of vertexes from the weaker parent,
+                                        as large as its share of the total fitness
+                             one-point: the vertexes after a random point of the bandwidth
+                                        reducing (Cuthill-McKee) order from the weaker parent
+                             two-point: the vertexes between two random points of that order
+                                        from the weaker parent
+                             conflict:  every gene from the parent without a conflict at the
+                                        vertex, from a random parent as uniform if neither or both
+        --stop-feasible 1  - stop at the first generation with a correct solution, the output
+                             then gives the time and the generations needed (default: 0)
+        --progress 1       - write a progress record whenever the best solution improves,
+                             see labeling/progress.h (default: 0)
+        --stats 1          - write the statistics of the run after the output, with the
+                             evaluations and the diversity of the generations (max. 100
+                             sample), see labeling/stats.h (default: 0)
+
+    DAEMON
+        argv[1] - --daemon
+        --workers n - number of jobs solved in parallel (default: number of cores)
+        --cache dir - directory of the preprocessed graphs (default: no cache)
+
+        Jobs with the arguments above are read from the standard input,
+        see labeling/daemon.h.
 
     OUTPUT
         line 1: time elapsed
@@ -21,125 +49,187 @@
         line 6: chromatic number
         line 7: fitness
         line 8: best fitness per generation (max. 100 sample)
+        line 9: statistics of the run (--stats 1)
+
+    Every population is an island evolved by its own thread. After every
+    MIGRATION_INTERVAL generations the islands meet and the fittest
+    chromosomes of every island replace the weakest ones of the next
+    island (ring topology).
 */
 
 #include <iostream>
-#include <fstream>
+#include <cstdlib>
 #include <cstring>
 #include <cmath>
 #include <ctime>
 #include <algorithm>
+#include <atomic>
+#include <sstream>
+#include <stdexcept>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "labeling/graph.h"
+#include "labeling/solution.h"
+#include "labeling/evaluator.h"
+#include "labeling/graph_cache.h"
+#include "labeling/barrier.h"
+#include "labeling/daemon.h"
+#include "labeling/options.h"
+#include "labeling/progress.h"
+#include "labeling/random.h"
+#include "labeling/stats.h"
+#include "labeling/timer.h"
 
 #define SELECTION_PERCENTAGE 0.05  // 0 <= x <= 1
+#define MIGRATION_PERCENTAGE 0.05  // 0 <= x <= 1
+#define MIGRATION_INTERVAL 10      // generations between two migrations
+#define INCREMENTAL_LIMIT 0.25     // max. share of changed genes to evaluate an offspring from its parent (0 <= x <= 1)
 
 using namespace std;
 
-struct parameters
+enum crossover_type
+{
+    UNIFORM_CROSSOVER,
+    BLOCK_CROSSOVER,
+    ONE_POINT_CROSSOVER,
+    TWO_POINT_CROSSOVER,
+    CONFLICT_CROSSOVER
+};
+
+struct parameters : constraints
 {
-    int h;                          // min. difference between adjacent vertexes
-    int k;                          // min. difference between vertexes at distance of 2 edges
     char* file;                     // input file path
-    int max_label;                  // max. value of a label
 
     int populations_count;          // number of populations
     int population_size;            // number of chromosomes in one population
     double mutation_chance;         // chance of a chromosome to mutate (0 <= x <= 1)
     int elites;                     // number of fittest chromosomes to keep
+    crossover_type crossover;       // crossover operator
 
     int max_generations;            // max. number of iterations
-    int max_time;                   // max. running time (seconds)
+    double max_time;                // max. running time (seconds)
+    double start_time;              // time the run started
+    deadline time_limit;            // end of the run
+    bool stop_feasible;             // stop at the first correct solution
+
+    uint64_t seed;                  // seed of the random number generators
+    const char* cache_path;         // directory of the preprocessed graphs (NULL: no cache)
+    progress progress_records;      // progress records of the run
+    stats run_stats;                // statistics of the run
 };
 
-struct data
+template<typename label_type>
+using chromosome = solution<label_type>;    // proposed solution, its labels are the genes
+
+template<typename label_type>
+struct population
 {
-    int vertex_count;               // number of vertexes
-    int edge_count;                 // number of edges
-    int fixed_vertex_count;         // number of predefined vertexes
-
-    bool** graph;                   // graph adjacency matrix
-    int** neighbors;                // array of adjacent vertexes for every vertex
-    int** second_neighbors;         // array of vertexes at distance of 2 edges for each vertex
-    int* solution_backbone;         // fixed vertexes of the solution
+    chromosome<label_type>* chromosomes;        // grouped solutions
+    double* fitness;                            // fitness of every chromosome
+    int* order;                                 // chromosome indexes, the selected ones first (set by select_chromosomes)
 };
 
-struct chromosome
+template<typename label_type>
+struct generation
 {
-    int* genes;                     // proposed solution
-
-    bool is_correct;                // solution correctness
-    int conflicting_genes;          // solution conflicting vertexes count
-    int chromatic_number;           // solution chromatic number
-    double fitness;                 // solution fitness
+    int generation_number;                      // iteration counter
+    double* fitness_history;                    // best fitness from every generation
+    chromosome<label_type>* best_chromosome;    // best solution
+
+    population<label_type>* populations;        // array of grouped solutions
+    chromosome<label_type>* chromosomes;        // chromosomes of all populations, their genes share one arena
+    double* fitness;                            // fitness of all chromosomes
+    int* order;                                 // chromosome indexes of all populations
 };
 
-struct population
+struct island
 {
-    chromosome* chromosomes;        // grouped solutions
+    int index;                      // index of the evolved population
+    int generation_number;          // generations created by the island
+    random_generator generator;     // random number generator of the island
+    deadline time_limit;            // end of the run, asked by the island
+
+    int* changed;                   // genes of an offspring that differ from its fitter parent
+    int* block;                     // vertexes of a block crossover in breadth first order
+    int* visited;                   // block crossover that last reached every vertex
+    int crossovers;                 // block crossovers done
+
+    int evaluations;                // offsprings of the generation evaluated in full (statistics)
+    int incremental_evaluations;    // offsprings of the generation evaluated from their fitter parent (statistics)
 };
 
-struct generation
+struct generation_stats
 {
-    int generation_number;          // iteration counter
-    double* fitness_history;        // best fitness from every generation
-    chromosome* best_chromosome;    // best solution
-
-    population* populations;        // array of grouped solutions
+    int64_t evaluations;            // chromosomes evaluated in full by all islands
+    int64_t incremental_evaluations;// chromosomes evaluated from their fitter parent by all islands
+    double diversity;               // share of the genes differing from the fittest chromosome, averaged over the islands
 };
 
-void set_parameters(char**, parameters&);
-void initialize(parameters&, data&);
-void neighbors(data&);
-void second_neighbors(data&);
-
-void initialize(parameters&, data&, generation&, generation&);
-bool is_correct(parameters&, data&, chromosome&);
-bool is_conflicting_gene(parameters&, data&, chromosome&, int);
-int chromatic_number(parameters&, data&, chromosome&);
-double fitness(parameters&, data&, chromosome&);
+template<typename label_type>
+struct archipelago
+{
+    island* islands;                            // one island for every population
+    barrier* migration_barrier;                 // islands wait here for each other before a migration
+    mutex best_lock;                            // guards the fitness history and the best solution
+    bool stop;                                  // set at a migration when the run is over
+    atomic<bool> feasible;                      // a correct solution was found
+    int* vertex_order;                          // bandwidth reducing order of the vertexes (point crossovers)
+    generation_stats* history;                  // statistics of every generation (NULL: no statistics)
+
+    int migrants_count;                         // chromosomes sent to the next island at a migration
+    chromosome<label_type>* migrants;           // fittest chromosomes of every island
+};
 
-void create_next_generation(parameters&, data&, generation&, generation&);
-int selection(parameters&, population&);
-void crossover(data&, chromosome&, chromosome&, chromosome&);
-void mutation(parameters&, data&, chromosome&);
-bool compareByFitness(const chromosome&, const chromosome&);
-void print_data(parameters&, data&, generation&);
+void set_parameters(int, char**, ostream&, parameters&);
+void solve(int, char**, graph&, ostream&, ostream&);
+void solve(parameters&, graph&, ostream&);
+template<typename label_type> void solve(parameters&, graph&, ostream&);
+template<typename label_type> void initialize(parameters&, graph&, generation<label_type>&, generation<label_type>&);
+template<typename label_type> void allocate_generation(parameters&, graph&, generation<label_type>&);
+template<typename label_type> void initialize(parameters&, graph&, archipelago<label_type>&);
+
+template<typename label_type> void evolve(parameters&, graph&, generation<label_type>&, generation<label_type>&, archipelago<label_type>&, int);
+template<typename label_type> void migrate(parameters&, graph&, generation<label_type>&, generation<label_type>&, archipelago<label_type>&);
+template<typename label_type> void create_next_population(parameters&, graph&, generation<label_type>&, generation<label_type>&, archipelago<label_type>&, island&);
+template<typename label_type> int selection(parameters&, population<label_type>&, random_generator&);
+template<typename label_type> void crossover(parameters&, graph&, archipelago<label_type>&, island&, chromosome<label_type>&, chromosome<label_type>&, chromosome<label_type>&);
+template<typename label_type> void block_crossover(graph&, island&, chromosome<label_type>&, chromosome<label_type>&, double, chromosome<label_type>&);
+template<typename label_type> void evaluate_offspring(parameters&, graph&, island&, chromosome<label_type>&, chromosome<label_type>&, chromosome<label_type>&);
+template<typename label_type> void mutation(parameters&, graph&, chromosome<label_type>&, random_generator&);
+template<typename label_type> double population_diversity(parameters&, graph&, population<label_type>&, int);
+template<typename label_type> string generation_counters(archipelago<label_type>&, int);
+template<typename label_type> void select_chromosomes(parameters&, population<label_type>&, int, bool);
+template<typename label_type> void print_data(ostream&, parameters&, graph&, generation<label_type>&);
+template<typename label_type> void release(parameters&, generation<label_type>&, generation<label_type>&, archipelago<label_type>&);
 
 int main(int argc, char** argv)
 {
+    if(argc > 1 && strcmp(argv[1], "--daemon") == 0)
+    {
+        return run_daemon(argc, argv, solve);
+    }
+
     try
     {
         parameters parameters;
-        data data;
-        generation generation1;
-        generation generation2;
+        graph graph;
 
-        srand(time(NULL));
+        set_parameters(argc, argv, cout, parameters);
+        load_graph_file(parameters.file, parameters.cache_path, graph);
 
-        set_parameters(argv, parameters);
-        initialize(parameters, data);
-        initialize(parameters, data, generation1, generation2);
+        /* a signal stops the run early, it still writes the best solution found */
+        cancel_on_signals();
 
-        while(generation1.generation_number < parameters.max_generations &&
-              clock() / CLOCKS_PER_SEC < parameters.max_time)
-        {
-            if(generation1.generation_number % 2)
-            {
-                create_next_generation(parameters, data, generation2, generation1);
-            }
-            else
-            {
-                create_next_generation(parameters, data, generation1, generation2);
-            }
-        }
+        solve(parameters, graph, cout);
 
-        if(generation1.generation_number % 2)
-        {
-            print_data(parameters, data, generation2);
-        }
-        else
-        {
-            print_data(parameters, data, generation1);
-        }
+        free_graph(graph);
+    }
+    catch(input_error& error)
+    {
+        cout << "Error: invalid input file (line " << error.line << ")!" << endl;
+        return 1;
     }
     catch(...)
     {
@@ -150,219 +240,185 @@ int main(int argc, char** argv)
     return 0;
 }
 
-void set_parameters(char** argv, parameters& parameters)
+void set_parameters(int argc, char** argv, ostream& progress, parameters& parameters)
 {
+    if(argc < 11)
+    {
+        throw invalid_argument("argc");
+    }
+
+    parameters.start_time = current_time();
+
     /* store command line arguments in appropriate structures */
     parameters.h = atoi(argv[1]);
     parameters.k = atoi(argv[2]);
 
-    parameters.file = new char[strlen(argv[3]) + 1];
-    strcpy(parameters.file, argv[3]);
+    parameters.file = argv[3];
 
     parameters.max_label         = atoi(argv[4]);
     parameters.populations_count = atoi(argv[5]);
     parameters.population_size   = atoi(argv[6]);
     parameters.mutation_chance   = atof(argv[7]);
-    parameters.elites            = atoi(argv[8]);
+    parameters.elites            = max(0, min(atoi(argv[8]), parameters.population_size));
     parameters.max_generations   = atoi(argv[9]);
-    parameters.max_time          = atoi(argv[10]);
-}
+    parameters.max_time          = atof(argv[10]);
 
-void initialize(parameters& parameters, data& data)
-{
-    /* read data from file */
-    fstream file(parameters.file, ios_base::in);
+    /* a generation takes long enough to read the clock after every one */
+    set_deadline(parameters.time_limit, parameters.start_time, parameters.max_time, 1);
 
-    file >> data.vertex_count;
-    file >> data.edge_count;
-    file >> data.fixed_vertex_count;
+    const char* seed = get_option(argc, argv, 11, "seed");
+    parameters.seed = seed ? strtoull(seed, NULL, 10) : random_seed();
+    parameters.cache_path = get_option(argc, argv, 11, "cache");
+    parameters.stop_feasible = get_option(argc, argv, 11, "stop-feasible", 0) != 0;
+    start_progress(parameters.progress_records, get_option(argc, argv, 11, "progress", 0) ? &progress : NULL);
+    start_stats(parameters.run_stats, get_option(argc, argv, 11, "stats", 0) != 0, parameters.start_time);
 
-    /* allocate memory for adjacency matrix */
-    data.graph = new bool*[data.vertex_count];
-    for(int i = 0; i < data.vertex_count; ++i)
-    {
-        data.graph[i] = new bool[data.vertex_count]();
-    }
+    const char* crossover = get_option(argc, argv, 11, "crossover");
+    const char* crossover_names[] = {"uniform", "block", "one-point", "two-point", "conflict"};
+
+    parameters.crossover = UNIFORM_CROSSOVER;
 
-    /* fill adjacency matrix */
-    int vertex1, vertex2;
-    for(int i = 0; i < data.edge_count; ++i)
+    if(crossover)
     {
-        file >> vertex1 >> vertex2;
-        --vertex1; --vertex2;
+        int i = 0;
+        while(i < 5 && strcmp(crossover, crossover_names[i]) != 0)
+        {
+            ++i;
+        }
 
-        data.graph[vertex1][vertex2] = true;
-        data.graph[vertex2][vertex1] = true;
-    }
+        if(i == 5)
+        {
+            throw invalid_argument(crossover);
+        }
 
-    /* create solution backbone */
-    data.solution_backbone = new int[data.vertex_count]();
-    int vertex, value;
-    for (int i = 0; i < data.fixed_vertex_count; ++i)
-    {
-        file >> vertex >> value;
-        data.solution_backbone[--vertex] = value;
+        parameters.crossover = (crossover_type) i;
     }
+}
 
-    /* close file */
-    file.close();
+void solve(int argc, char** argv, graph& graph, ostream& output, ostream& progress)
+{
+    /* a daemon job, the graph is already loaded */
+    parameters parameters;
 
-    neighbors(data);
-    second_neighbors(data);
+    set_parameters(argc, argv, progress, parameters);
+    solve(parameters, graph, output);
 }
 
-void neighbors(data& data)
+void solve(parameters& parameters, graph& graph, ostream& output)
 {
-    /* allocate memory for every vertex */
-    data.neighbors = new int*[data.vertex_count];
+    end_phase(parameters.run_stats, LOAD_PHASE);
+    check_fixed_labels(parameters, graph);
 
-    /* for every vertex */
-    for(int i = 0; i < data.vertex_count; ++i)
+    /* store the genes in the narrowest type holding max. label */
+    if(parameters.max_label <= UINT8_MAX)
     {
-        /* calculate neighbors count */
-        int neighbors_count = 0;
-        for(int j = 0; j < data.vertex_count; ++j)
-        {
-            if(data.graph[i][j])
-            {
-                ++neighbors_count;
-            }
-        }
+        solve<uint8_t>(parameters, graph, output);
+    }
+    else if(parameters.max_label <= UINT16_MAX)
+    {
+        solve<uint16_t>(parameters, graph, output);
+    }
+    else
+    {
+        solve<int>(parameters, graph, output);
+    }
+}
 
-        /* allocate memory for neighbors */
-        data.neighbors[i] = new int[neighbors_count + 1];
+template<typename label_type>
+void solve(parameters& parameters, graph& graph, ostream& output)
+{
+    generation<label_type> generation1;
+    generation<label_type> generation2;
+    archipelago<label_type> archipelago;
 
-        /* fill neighbors */
-        int index = 0;
-        data.neighbors[i][0] = neighbors_count;
+    initialize(parameters, graph, generation1, generation2);
+    initialize(parameters, graph, archipelago);
 
-        for(int j = 0; j < data.vertex_count; ++j)
+    /* the initial populations may already hold a correct solution */
+    for(int i = 0; i < parameters.populations_count * parameters.population_size; ++i)
+    {
+        if(generation1.chromosomes[i].is_correct)
         {
-            if(data.graph[i][j])
+            archipelago.feasible = true;
+
+            if(parameters.stop_feasible && !generation1.best_chromosome->is_correct)
             {
-                data.neighbors[i][++index] = j;
+                copy_solution(graph, generation1.chromosomes[i], *generation1.best_chromosome);
             }
         }
     }
-}
-
-void second_neighbors(data& data)
-{
-    /* allocate memory for every vertex */
-    data.second_neighbors = new int*[data.vertex_count];
 
-    for(int i = 0; i < data.vertex_count; ++i)
+    /* the initial populations are the first generation of the statistics */
+    if(parameters.run_stats.enabled)
     {
-        /* calculate second neighbors count */
-        int second_neighbors_count = 0;
+        archipelago.history[0].evaluations = parameters.populations_count * parameters.population_size;
 
-        for(int j = 1; j <= data.neighbors[i][0]; ++j)
+        for(int i = 0; i < parameters.populations_count; ++i)
         {
-            second_neighbors_count += data.neighbors[data.neighbors[i][j]][0];
-        }
+            population<label_type>& population = generation1.populations[i];
+            int fittest_index = max_element(population.fitness, population.fitness + parameters.population_size) - population.fitness;
 
-        /* allocate memory for initial second neighbors */
-        int* second_neighbors = new int[second_neighbors_count + 1];
-
-        /* fill second neighbors */
-        int index = 0;
-        second_neighbors[0] = second_neighbors_count;
-
-        for(int j = 1; j <= data.neighbors[i][0]; ++j)
-        {
-            for(int k = 1; k <= data.neighbors[data.neighbors[i][j]][0]; ++k)
-            {
-                second_neighbors[++index] = data.neighbors[data.neighbors[i][j]][k];
-            }
+            archipelago.history[0].diversity += population_diversity(parameters, graph, population, fittest_index) /
+                                                parameters.populations_count;
         }
+    }
 
-        /* make second neighbors list a set */
-        int final_count = 0;
-        sort(second_neighbors + 1, second_neighbors + second_neighbors_count + 1);
+    end_phase(parameters.run_stats, PREPROCESS_PHASE);
 
-        for(int j = 1; j <= second_neighbors_count; ++j)
-        {
-            if(second_neighbors[j] != i)
-            {
-                if(j == 1)
-                {
-                    ++final_count;
-                }
-                else if(second_neighbors[j] != second_neighbors[j - 1])
-                {
-                    ++final_count;
-                }
-            }
-        }
+    /* evolve every population on its own thread */
+    vector<thread> threads;
 
-        /* allocate memory for final second neighbors */
-        data.second_neighbors[i] = new int[final_count + 1];
+    for(int i = 0; i < parameters.populations_count; ++i)
+    {
+        threads.push_back(thread(evolve<label_type>, ref(parameters), ref(graph), ref(generation1), ref(generation2), ref(archipelago), i));
+    }
 
-        index = 0;
-        data.second_neighbors[i][0] = final_count;
+    for(size_t i = 0; i < threads.size(); ++i)
+    {
+        threads[i].join();
+    }
 
-        for(int j = 1; j <= second_neighbors_count; ++j)
-        {
-            if(second_neighbors[j] != i)
-            {
-                if(j == 1)
-                {
-                    data.second_neighbors[i][++index] = second_neighbors[j];
-                }
-                else if(second_neighbors[j] != second_neighbors[j - 1])
-                {
-                    data.second_neighbors[i][++index] = second_neighbors[j];
-                }
-            }
-        }
+    end_phase(parameters.run_stats, SEARCH_PHASE);
+
+    print_data(output, parameters, graph, generation1);
 
-        delete[] second_neighbors;
+    /* the fitness history is not closed by a new line */
+    if(parameters.run_stats.enabled)
+    {
+        output << endl;
+        write_stats(output, parameters.run_stats, generation_counters(archipelago, generation1.generation_number));
     }
+
+    release(parameters, generation1, generation2, archipelago);
 }
 
-void initialize(parameters& parameters, data& data, generation& g1, generation& g2)
+template<typename label_type>
+void initialize(parameters& parameters, graph& graph, generation<label_type>& g1, generation<label_type>& g2)
 {
-    g1.fitness_history = g2.fitness_history = new double[parameters.max_generations]();
-    g1.best_chromosome = g2.best_chromosome = new chromosome;
-    g1.best_chromosome->genes = new int[data.vertex_count];
-    g1.best_chromosome->fitness = -1;
+    /* the initial populations use the stream after the ones of the islands */
+    random_generator generator;
+    seed_generator(generator, parameters.seed, parameters.populations_count);
+
+    g1.fitness_history = g2.fitness_history = new double[parameters.max_generations + 1]();
+    g1.best_chromosome = g2.best_chromosome = new chromosome<label_type>;
+    allocate_solution(parameters, graph, *g1.best_chromosome, false);
 
     g1.generation_number = 0;
     g2.generation_number = 0;
 
-    /* allocate memory for populations */
-    g1.populations = new population[parameters.populations_count];
-    g2.populations = new population[parameters.populations_count];
+    allocate_generation(parameters, graph, g1);
+    allocate_generation(parameters, graph, g2);
 
-    /* allocate memory for chromosomes */
     for(int i = 0; i < parameters.populations_count; ++i)
     {
-        g1.populations[i].chromosomes = new chromosome[parameters.population_size];
-        g2.populations[i].chromosomes = new chromosome[parameters.population_size];
-
-        /* allocate memory for genes */
         for(int j = 0; j < parameters.population_size; ++j)
         {
-            g1.populations[i].chromosomes[j].genes = new int[data.vertex_count];
-            g2.populations[i].chromosomes[j].genes = new int[data.vertex_count];
-
             /* initialize random genes */
-            for(int k = 0; k < data.vertex_count; ++k)
-            {
-                if(data.solution_backbone[k])
-                {
-                    g1.populations[i].chromosomes[j].genes[k] = data.solution_backbone[k];
-                }
-                else
-                {
-                    g1.populations[i].chromosomes[j].genes[k] = rand() % parameters.max_label + 1;
-                }
-            }
+            random_solution(parameters, graph, g1.populations[i].chromosomes[j], generator);
 
             /* evaluate chromosome */
-            g1.populations[i].chromosomes[j].is_correct = is_correct(parameters, data, g1.populations[i].chromosomes[j]);
-            g1.populations[i].chromosomes[j].chromatic_number = chromatic_number(parameters, data, g1.populations[i].chromosomes[j]);
-            g1.populations[i].chromosomes[j].fitness = fitness(parameters, data, g1.populations[i].chromosomes[j]);
+            evaluate(parameters, graph, g1.populations[i].chromosomes[j]);
+            g1.populations[i].fitness[j] = g1.populations[i].chromosomes[j].fitness;
 
             if(g1.populations[i].chromosomes[j].fitness > g1.fitness_history[0])
             {
@@ -370,264 +426,545 @@ void initialize(parameters& parameters, data& data, generation& g1, generation&
 
                 if(g1.populations[i].chromosomes[j].fitness > g1.best_chromosome->fitness)
                 {
-                    copy(g1.populations[i].chromosomes[j].genes,
-                         g1.populations[i].chromosomes[j].genes + data.vertex_count,
-                         g1.best_chromosome->genes);
-
-                    g1.best_chromosome->is_correct = g1.populations[i].chromosomes[j].is_correct;
-                    g1.best_chromosome->conflicting_genes = g1.populations[i].chromosomes[j].conflicting_genes;
-                    g1.best_chromosome->chromatic_number = g1.populations[i].chromosomes[j].chromatic_number;
-                    g1.best_chromosome->fitness = g1.populations[i].chromosomes[j].fitness;
+                    copy_solution(graph, g1.populations[i].chromosomes[j], *g1.best_chromosome);
                 }
             }
         }
     }
 }
 
-bool is_correct(parameters& parameters, data& data, chromosome& chromosome)
+template<typename label_type>
+void allocate_generation(parameters& parameters, graph& graph, generation<label_type>& generation)
+{
+    int chromosomes_count = parameters.populations_count * parameters.population_size;
+
+    generation.chromosomes = new chromosome<label_type>[chromosomes_count];
+    generation.fitness = new double[chromosomes_count];
+    generation.order = new int[chromosomes_count];
+    allocate_solutions(parameters, graph, generation.chromosomes, chromosomes_count, true);
+
+    /* every population is a slice of the arrays of the generation */
+    generation.populations = new population<label_type>[parameters.populations_count];
+
+    for(int i = 0; i < parameters.populations_count; ++i)
+    {
+        generation.populations[i].chromosomes = generation.chromosomes + i * parameters.population_size;
+        generation.populations[i].fitness = generation.fitness + i * parameters.population_size;
+        generation.populations[i].order = generation.order + i * parameters.population_size;
+    }
+}
+
+template<typename label_type>
+void initialize(parameters& parameters, graph& graph, archipelago<label_type>& archipelago)
+{
+    archipelago.islands = new island[parameters.populations_count];
+
+    for(int i = 0; i < parameters.populations_count; ++i)
+    {
+        island& island = archipelago.islands[i];
+
+        island.index = i;
+        island.generation_number = 0;
+        seed_generator(island.generator, parameters.seed, i);
+        island.time_limit = parameters.time_limit;
+
+        /* work arrays of the crossovers */
+        island.changed = new int[graph.vertex_count];
+        island.block = new int[graph.vertex_count];
+        island.visited = new int[graph.vertex_count]();
+        island.crossovers = 0;
+
+        island.evaluations = 0;
+        island.incremental_evaluations = 0;
+    }
+
+    archipelago.migration_barrier = new barrier(parameters.populations_count);
+    archipelago.stop = false;
+    archipelago.feasible = false;
+
+    archipelago.vertex_order = NULL;
+    archipelago.history = parameters.run_stats.enabled ? new generation_stats[parameters.max_generations + 1]() : NULL;
+
+    if(parameters.crossover == ONE_POINT_CROSSOVER || parameters.crossover == TWO_POINT_CROSSOVER)
+    {
+        archipelago.vertex_order = new int[graph.vertex_count];
+        bandwidth_order(graph, archipelago.vertex_order);
+    }
+
+    /* allocate memory for the migrants of every island */
+    archipelago.migrants_count = min(parameters.population_size,
+                                     max(1, (int) floor(parameters.population_size * MIGRATION_PERCENTAGE)));
+    archipelago.migrants = new chromosome<label_type>[parameters.populations_count * archipelago.migrants_count];
+    allocate_solutions(parameters, graph, archipelago.migrants, parameters.populations_count * archipelago.migrants_count, true);
+}
+
+template<typename label_type>
+void evolve(parameters& parameters, graph& graph, generation<label_type>& g1, generation<label_type>& g2, archipelago<label_type>& archipelago, int index)
 {
-    bool correctness = true;
-    chromosome.conflicting_genes = 0;
+    island& island = archipelago.islands[index];
 
-    for(int i = 0; i < data.vertex_count; ++i)
+    while(!archipelago.stop)
     {
-        if(is_conflicting_gene(parameters, data, chromosome, i))
+        /* evolve the population alone until the next migration */
+        for(int i = 0; i < MIGRATION_INTERVAL &&
+                        island.generation_number < parameters.max_generations &&
+                        !time_is_up(island.time_limit) &&
+                        !(parameters.stop_feasible && archipelago.feasible); ++i)
         {
-            if(data.solution_backbone[i] == 0)
+            if(island.generation_number % 2)
             {
-                ++chromosome.conflicting_genes;
+                create_next_population(parameters, graph, g2, g1, archipelago, island);
+            }
+            else
+            {
+                create_next_population(parameters, graph, g1, g2, archipelago, island);
             }
-            correctness = false;
         }
-    }
 
-    return correctness;
+        archipelago.migration_barrier->arrive_and_wait([&]
+        {
+            /* every island created the same number of generations unless the time is up */
+            int generation_number = 0;
+            for(int i = 0; i < parameters.populations_count; ++i)
+            {
+                generation_number = max(generation_number, archipelago.islands[i].generation_number);
+            }
+            g1.generation_number = g2.generation_number = generation_number;
+
+            if(generation_number >= parameters.max_generations || is_expired(island.time_limit) ||
+               (parameters.stop_feasible && archipelago.feasible))
+            {
+                archipelago.stop = true;
+            }
+            else
+            {
+                migrate(parameters, graph, g1, g2, archipelago);
+            }
+        });
+    }
 }
 
-bool is_conflicting_gene(parameters& parameters, data& data, chromosome& chromosome, int gene)
+template<typename label_type>
+void migrate(parameters& parameters, graph& graph, generation<label_type>& g1, generation<label_type>& g2, archipelago<label_type>& archipelago)
 {
-    /* check neighbors */
-    for(int i = 1; i <= data.neighbors[gene][0]; ++i)
+    if(parameters.populations_count < 2)
+    {
+        return;
+    }
+
+    /* the islands are in step here, so their latest populations belong to the same generation */
+    population<label_type>* populations = g1.generation_number % 2 ? g2.populations : g1.populations;
+
+    /* save the fittest chromosomes of every island before any of them is replaced */
+    for(int i = 0; i < parameters.populations_count; ++i)
     {
-        if(abs(chromosome.genes[gene] - chromosome.genes[data.neighbors[gene][i]]) < parameters.h)
+        select_chromosomes(parameters, populations[i], archipelago.migrants_count, true);
+
+        for(int j = 0; j < archipelago.migrants_count; ++j)
         {
-            return true;
+            copy_tracked_solution(parameters, graph, populations[i].chromosomes[populations[i].order[j]],
+                                  archipelago.migrants[i * archipelago.migrants_count + j]);
         }
     }
 
-    /* check second neighbors */
-    for(int i = 1; i <= data.second_neighbors[gene][0]; ++i)
+    /* replace the weakest chromosomes of the next island */
+    for(int i = 0; i < parameters.populations_count; ++i)
     {
-        if(abs(chromosome.genes[gene] - chromosome.genes[data.second_neighbors[gene][i]]) < parameters.k)
+        population<label_type>& target = populations[(i + 1) % parameters.populations_count];
+        select_chromosomes(parameters, target, archipelago.migrants_count, false);
+
+        for(int j = 0; j < archipelago.migrants_count; ++j)
         {
-            return true;
+            int weakest = target.order[j];
+
+            copy_tracked_solution(parameters, graph, archipelago.migrants[i * archipelago.migrants_count + j], target.chromosomes[weakest]);
+            target.fitness[weakest] = target.chromosomes[weakest].fitness;
         }
     }
-
-    return false;
 }
 
-int chromatic_number(parameters& parameters, data& data, chromosome& chromosome)
+template<typename label_type>
+void create_next_population(parameters& parameters, graph& graph, generation<label_type>& current_generation, generation<label_type>& next_generation, archipelago<label_type>& archipelago, island& island)
 {
-    int max_label = chromosome.genes[0];
+    int generation_number = ++island.generation_number;
+    population<label_type>& current_population = current_generation.populations[island.index];
+    population<label_type>& next_population = next_generation.populations[island.index];
+
+    /* save elites */
+    select_chromosomes(parameters, current_population, parameters.elites, true);
+
+    for(int j = 0; j < parameters.elites; ++j)
+    {
+        copy_tracked_solution(parameters, graph, current_population.chromosomes[current_population.order[j]], next_population.chromosomes[j]);
+        next_population.fitness[j] = next_population.chromosomes[j].fitness;
+    }
+
+    /* for every new chromosome */
+    for(int j = parameters.elites; j < parameters.population_size; ++j)
+    {
+        int parent1_index = selection(parameters, current_population, island.generator);
+        int parent2_index = selection(parameters, current_population, island.generator);
+
+        /* the new chromosome is evaluated by the crossover */
+        crossover(parameters, graph, archipelago, island,
+                  current_population.chromosomes[parent1_index],
+                  current_population.chromosomes[parent2_index],
+                  next_population.chromosomes[j]);
+
+        mutation(parameters, graph, next_population.chromosomes[j], island.generator);
+        next_population.fitness[j] = next_population.chromosomes[j].fitness;
+    }
+
+    /* find the fittest chromosome and the fittest correct one of the new population */
+    int fittest_index = 0;
+    int feasible_index = -1;
+
+    for(int j = 0; j < parameters.population_size; ++j)
+    {
+        if(next_population.fitness[j] > next_population.fitness[fittest_index])
+        {
+            fittest_index = j;
+        }
+
+        if(next_population.chromosomes[j].is_correct &&
+           (feasible_index < 0 || next_population.fitness[j] > next_population.fitness[feasible_index]))
+        {
+            feasible_index = j;
+        }
+    }
+
+    chromosome<label_type>* fittest = &next_population.chromosomes[fittest_index];
+
+    /* the diversity is measured before the islands are locked */
+    double diversity = parameters.run_stats.enabled ? population_diversity(parameters, graph, next_population, fittest_index) : 0;
 
-    for(int i = 1; i < data.vertex_count; ++i)
+    /* the fitness history and the best solution are shared by all islands */
+    lock_guard<mutex> guard(archipelago.best_lock);
+
+    if(parameters.run_stats.enabled)
     {
-        if(chromosome.genes[i] > max_label)
+        generation_stats& history = archipelago.history[generation_number];
+
+        history.evaluations += island.evaluations;
+        history.incremental_evaluations += island.incremental_evaluations;
+        history.diversity += diversity / parameters.populations_count;
+
+        island.evaluations = 0;
+        island.incremental_evaluations = 0;
+    }
+
+    if(fittest->fitness > next_generation.fitness_history[generation_number])
+    {
+        next_generation.fitness_history[generation_number] = fittest->fitness;
+
+        if(fittest->fitness > next_generation.best_chromosome->fitness)
         {
-            max_label = chromosome.genes[i];
+            copy_solution(graph, *fittest, *next_generation.best_chromosome);
         }
     }
 
-    return max_label;
+    if(feasible_index >= 0)
+    {
+        archipelago.feasible = true;
+
+        /* a run stopped at the first correct solution reports it */
+        if(parameters.stop_feasible && !next_generation.best_chromosome->is_correct)
+        {
+            copy_solution(graph, next_population.chromosomes[feasible_index], *next_generation.best_chromosome);
+        }
+    }
+
+    /* a progress record is only written if the best solution improved since the last one */
+    report_progress(parameters.progress_records, parameters.start_time, generation_number, graph, *next_generation.best_chromosome);
 }
 
-double fitness(parameters& parameters, data& data, chromosome& chromosome)
+template<typename label_type>
+int selection(parameters& parameters, population<label_type>& population, random_generator& generator)
 {
-    return (4 * (1 - (double)chromosome.conflicting_genes / data.vertex_count) + (1 - (double)chromosome.chromatic_number / parameters.max_label)) / 5;
+    /* initial random selection */
+    int index = random_int(generator, parameters.population_size);
+    double fitness = population.fitness[index];
+
+    /* calculate the max number of random candidates to pick for the tournament */
+    int max_candidates = floor(parameters.population_size * SELECTION_PERCENTAGE) - 1;
+
+    for(int i = 0; i < max_candidates; ++i)
+    {
+        int random_index = random_int(generator, parameters.population_size);
+
+        if(population.fitness[random_index] > fitness)
+        {
+            index = random_index;
+            fitness = population.fitness[random_index];
+        }
+    }
+
+    return index;
 }
 
-void create_next_generation(parameters& parameters, data& data, generation& current_generation, generation& next_generation)
+template<typename label_type>
+void crossover(parameters& parameters, graph& graph, archipelago<label_type>& archipelago, island& island,
+               chromosome<label_type>& parent1, chromosome<label_type>& parent2, chromosome<label_type>& offspring)
 {
-    /* increment both iteration counters */
-    next_generation.generation_number = ++current_generation.generation_number;
+    /* the offspring is the fitter parent with some genes of the other one */
+    chromosome<label_type>& fitter = parent1.fitness >= parent2.fitness ? parent1 : parent2;
+    chromosome<label_type>& weaker = parent1.fitness >= parent2.fitness ? parent2 : parent1;
+    double weaker_share = weaker.fitness / (parent1.fitness + parent2.fitness);
 
-    /* for every population */
-    for(int i = 0; i < parameters.populations_count; ++i)
+    switch(parameters.crossover)
     {
-        /* save elites */
-        sort(current_generation.populations[i].chromosomes, current_generation.populations[i].chromosomes + parameters.population_size, compareByFitness);
+        case UNIFORM_CROSSOVER:
+        {
+            for(int i = 0; i < graph.vertex_count; ++i)
+            {
+                offspring.labels[i] = random_double(island.generator) < weaker_share ? weaker.labels[i] : fitter.labels[i];
+            }
+            break;
+        }
 
-        for(int j = 0; j < parameters.elites; ++j)
+        case BLOCK_CROSSOVER:
         {
-            copy(current_generation.populations[i].chromosomes[j].genes,
-                 current_generation.populations[i].chromosomes[j].genes + data.vertex_count,
-                 next_generation.populations[i].chromosomes[j].genes);
+            block_crossover(graph, island, fitter, weaker, weaker_share, offspring);
+            break;
+        }
 
-            next_generation.populations[i].chromosomes[j].is_correct = current_generation.populations[i].chromosomes[j].is_correct;
-            next_generation.populations[i].chromosomes[j].conflicting_genes = current_generation.populations[i].chromosomes[j].conflicting_genes;
-            next_generation.populations[i].chromosomes[j].chromatic_number = current_generation.populations[i].chromosomes[j].chromatic_number;
-            next_generation.populations[i].chromosomes[j].fitness = current_generation.populations[i].chromosomes[j].fitness;
+        case ONE_POINT_CROSSOVER:
+        case TWO_POINT_CROSSOVER:
+        {
+            /* neighboring vertexes are close in the order, so a segment of it is a region of the graph */
+            int first = random_int(island.generator, graph.vertex_count + 1);
+            int last = graph.vertex_count;
 
-            if(next_generation.populations[i].chromosomes[j].fitness > next_generation.fitness_history[next_generation.generation_number])
+            if(parameters.crossover == TWO_POINT_CROSSOVER)
             {
-                next_generation.fitness_history[next_generation.generation_number] = next_generation.populations[i].chromosomes[j].fitness;
+                last = random_int(island.generator, graph.vertex_count + 1);
 
-                if(next_generation.populations[i].chromosomes[j].fitness > next_generation.best_chromosome->fitness)
+                if(first > last)
                 {
-                    copy(next_generation.populations[i].chromosomes[j].genes,
-                         next_generation.populations[i].chromosomes[j].genes + data.vertex_count,
-                         next_generation.best_chromosome->genes);
-
-                    next_generation.best_chromosome->is_correct = next_generation.populations[i].chromosomes[j].is_correct;
-                    next_generation.best_chromosome->conflicting_genes = next_generation.populations[i].chromosomes[j].conflicting_genes;
-                    next_generation.best_chromosome->chromatic_number = next_generation.populations[i].chromosomes[j].chromatic_number;
-                    next_generation.best_chromosome->fitness = next_generation.populations[i].chromosomes[j].fitness;
+                    swap(first, last);
                 }
             }
-        }
 
-        /* for every new chromosome */
-        for(int j = parameters.elites; j < parameters.population_size; ++j)
-        {
-            int parent1_index = selection(parameters, current_generation.populations[i]);
-            int parent2_index = selection(parameters, current_generation.populations[i]);
-
-            crossover(data,
-                      current_generation.populations[i].chromosomes[parent1_index],
-                      current_generation.populations[i].chromosomes[parent2_index],
-                      next_generation.populations[i].chromosomes[j]);
+            copy(fitter.labels, fitter.labels + graph.vertex_count, offspring.labels);
 
-            mutation(parameters, data, next_generation.populations[i].chromosomes[j]);
-
-            /* evaluate chromosome */
-            next_generation.populations[i].chromosomes[j].is_correct = is_correct(parameters, data, next_generation.populations[i].chromosomes[j]);
-            next_generation.populations[i].chromosomes[j].chromatic_number = chromatic_number(parameters, data, next_generation.populations[i].chromosomes[j]);
-            next_generation.populations[i].chromosomes[j].fitness = fitness(parameters, data, next_generation.populations[i].chromosomes[j]);
+            for(int i = first; i < last; ++i)
+            {
+                offspring.labels[archipelago.vertex_order[i]] = weaker.labels[archipelago.vertex_order[i]];
+            }
+            break;
+        }
 
-            if(next_generation.populations[i].chromosomes[j].fitness > next_generation.fitness_history[next_generation.generation_number])
+        case CONFLICT_CROSSOVER:
+        {
+            for(int i = 0; i < graph.vertex_count; ++i)
             {
-                next_generation.fitness_history[next_generation.generation_number] = next_generation.populations[i].chromosomes[j].fitness;
+                bool fitter_conflicting = fitter.conflicts[i] > 0;
+                bool weaker_conflicting = weaker.conflicts[i] > 0;
 
-                if(next_generation.populations[i].chromosomes[j].fitness > next_generation.best_chromosome->fitness)
+                if(fitter_conflicting != weaker_conflicting)
                 {
-                    copy(next_generation.populations[i].chromosomes[j].genes,
-                         next_generation.populations[i].chromosomes[j].genes + data.vertex_count,
-                         next_generation.best_chromosome->genes);
-
-                    next_generation.best_chromosome->is_correct = next_generation.populations[i].chromosomes[j].is_correct;
-                    next_generation.best_chromosome->conflicting_genes = next_generation.populations[i].chromosomes[j].conflicting_genes;
-                    next_generation.best_chromosome->chromatic_number = next_generation.populations[i].chromosomes[j].chromatic_number;
-                    next_generation.best_chromosome->fitness = next_generation.populations[i].chromosomes[j].fitness;
+                    offspring.labels[i] = fitter_conflicting ? weaker.labels[i] : fitter.labels[i];
+                }
+                else
+                {
+                    offspring.labels[i] = random_double(island.generator) < weaker_share ? weaker.labels[i] : fitter.labels[i];
                 }
             }
+            break;
         }
     }
+
+    evaluate_offspring(parameters, graph, island, fitter, weaker, offspring);
 }
 
-int selection(parameters& parameters, population& population)
+template<typename label_type>
+void block_crossover(graph& graph, island& island, chromosome<label_type>& fitter, chromosome<label_type>& weaker,
+                     double weaker_share, chromosome<label_type>& offspring)
 {
-    /* initial random selection */
-    int index = rand() % parameters.population_size;
-    double fitness = population.chromosomes[index].fitness;
+    /* grow breadth first blocks from random vertexes until they cover the share of the weaker parent */
+    int size = weaker_share > 0 ? (int) round(weaker_share * graph.vertex_count) : 0;
+    int count = 0;
+    int stamp = ++island.crossovers;
 
-    /* calculate the max number of random candidates to pick for the tournament */
-    int max_candidates = floor(parameters.population_size * SELECTION_PERCENTAGE) - 1;
-
-    for(int i = 0; i < max_candidates; ++i)
+    while(count < size)
     {
-        int random_index = rand() % parameters.population_size;
+        int root = random_int(island.generator, graph.vertex_count);
 
-        if(population.chromosomes[random_index].fitness > fitness)
+        if(island.visited[root] == stamp)
         {
-            index = random_index;
-            fitness = population.chromosomes[random_index].fitness;
+            continue;
+        }
+
+        island.visited[root] = stamp;
+        island.block[count++] = root;
+
+        for(int head = count - 1; head < count && count < size; ++head)
+        {
+            int vertex = island.block[head];
+
+            for(int i = graph.neighbor_offsets[vertex]; i < graph.neighbor_offsets[vertex + 1] && count < size; ++i)
+            {
+                if(island.visited[graph.neighbors[i]] != stamp)
+                {
+                    island.visited[graph.neighbors[i]] = stamp;
+                    island.block[count++] = graph.neighbors[i];
+                }
+            }
         }
     }
 
-    return index;
+    copy(fitter.labels, fitter.labels + graph.vertex_count, offspring.labels);
+
+    for(int i = 0; i < count; ++i)
+    {
+        offspring.labels[island.block[i]] = weaker.labels[island.block[i]];
+    }
 }
 
-void crossover(data& data, chromosome& parent1, chromosome& parent2, chromosome& offspring)
+template<typename label_type>
+void evaluate_offspring(parameters& parameters, graph& graph, island& island,
+                        chromosome<label_type>& fitter, chromosome<label_type>& weaker, chromosome<label_type>& offspring)
 {
-    double total_fitness = parent1.fitness + parent2.fitness;
-    double parent1_dominance = parent1.fitness / total_fitness;
+    /* list the genes the offspring took from the weaker parent, as long as they are few */
+    int limit = INCREMENTAL_LIMIT * graph.vertex_count;
+    int changes = 0;
 
-    for(int i = 0; i < data.vertex_count; ++i)
+    for(int i = 0; i < graph.vertex_count && changes <= limit; ++i)
     {
-        if((double)rand() / RAND_MAX < parent1_dominance)
+        if(offspring.labels[i] != fitter.labels[i])
         {
-            offspring.genes[i] = parent1.genes[i];
+            island.changed[changes++] = i;
         }
-        else
+    }
+
+    if(changes > limit)
+    {
+        if(parameters.run_stats.enabled)
         {
-            offspring.genes[i] = parent2.genes[i];
+            ++island.evaluations;
         }
+
+        evaluate(parameters, graph, offspring);
+        return;
+    }
+
+    if(parameters.run_stats.enabled)
+    {
+        ++island.incremental_evaluations;
+    }
+
+    /* start from the evaluated fitter parent, the evaluation follows the changed genes */
+    copy_tracked_solution(parameters, graph, fitter, offspring);
+
+    for(int i = 0; i < changes; ++i)
+    {
+        relabel(parameters, graph, offspring, island.changed[i], weaker.labels[island.changed[i]]);
     }
 }
 
-void mutation(parameters& parameters, data& data, chromosome& chromosome)
+template<typename label_type>
+void mutation(parameters& parameters, graph& graph, chromosome<label_type>& chromosome, random_generator& generator)
 {
-    if((double)rand() / RAND_MAX > parameters.mutation_chance)
+    /* with every vertex predefined there is no gene to change */
+    if(random_double(generator) > parameters.mutation_chance || graph.fixed_vertex_count == graph.vertex_count)
     {
         return;
     }
 
-    /* change a random conflicting vertex to a random label */
+    /* change a random conflicting vertex to a random label, the evaluation follows the change */
     int random_gene;
 
-    if(chromosome.conflicting_genes)
+    if(chromosome.conflicting_vertexes)
     {
-        random_gene = rand() % chromosome.conflicting_genes;
-
-        for(int i = 0; i < data.vertex_count; ++i)
-        {
-            if(0 == data.solution_backbone[i] &&
-               is_conflicting_gene(parameters, data, chromosome, i) &&
-               0 == random_gene--)
-            {
-                chromosome.genes[i] = rand() % parameters.max_label + 1;
-                break;
-            }
-        }
+        random_gene = random_conflicting_vertex(chromosome, generator);
     }
     else
     {
-        random_gene = rand() % (data.vertex_count - data.fixed_vertex_count);
+        random_gene = graph.free_vertexes[random_int(generator, graph.vertex_count - graph.fixed_vertex_count)];
+    }
+
+    relabel(parameters, graph, chromosome, random_gene, random_int(generator, parameters.max_label) + 1);
+}
+
+template<typename label_type>
+double population_diversity(parameters& parameters, graph& graph, population<label_type>& population, int fittest_index)
+{
+    /* share of the genes of the population differing from the genes of its fittest chromosome */
+    label_type* fittest = population.chromosomes[fittest_index].labels;
+    int64_t differences = 0;
+
+    for(int j = 0; j < parameters.population_size; ++j)
+    {
+        label_type* labels = population.chromosomes[j].labels;
 
-        for(int i = 0; i < data.vertex_count; ++i)
+        for(int i = 0; i < graph.vertex_count; ++i)
         {
-            if(0 == data.solution_backbone[i] && 0 == random_gene--)
-            {
-                chromosome.genes[i] = rand() % parameters.max_label + 1;
-                break;
-            }
+            differences += labels[i] != fittest[i];
         }
     }
+
+    return (double) differences / ((double) parameters.population_size * graph.vertex_count);
 }
 
-bool compareByFitness(const chromosome& a, const chromosome& b)
+template<typename label_type>
+string generation_counters(archipelago<label_type>& archipelago, int generations)
 {
-    return a.fitness > b.fitness;
+    /* max. 100 sample of the generations created, the first one is the initial populations */
+    ostringstream counters;
+    counters << "\"generations\":[";
+
+    for(int i = 0; i <= generations; i += ceil((double) (generations + 1) / 100))
+    {
+        generation_stats& history = archipelago.history[i];
+
+        counters << (i ? "," : "") << "{\"generation\":" << i << ",\"evaluations\":" << history.evaluations;
+        counters << ",\"incrementalEvaluations\":" << history.incremental_evaluations;
+        counters << ",\"diversity\":" << json_number(history.diversity) << '}';
+    }
+
+    counters << ']';
+
+    return counters.str();
 }
 
-void print_data(parameters& parameters, data& data, generation& generation)
+template<typename label_type>
+void select_chromosomes(parameters& parameters, population<label_type>& population, int count, bool fittest)
 {
-    cout << (double) clock() / CLOCKS_PER_SEC << endl;
-    cout << generation.generation_number << endl;
+    /* move the indexes of the count fittest (or weakest) chromosomes to the front in linear time, in no particular order */
+    for(int i = 0; i < parameters.population_size; ++i)
+    {
+        population.order[i] = i;
+    }
+
+    if(count <= 0 || count >= parameters.population_size)
+    {
+        return;
+    }
+
+    nth_element(population.order, population.order + count, population.order + parameters.population_size, [&](int a, int b)
+    {
+        return fittest ? population.fitness[a] > population.fitness[b] : population.fitness[a] < population.fitness[b];
+    });
+}
+
+template<typename label_type>
+void print_data(ostream& output, parameters& parameters, graph& graph, generation<label_type>& generation)
+{
+    output << elapsed_time(parameters.start_time) << endl;
+    output << generation.generation_number << endl;
 
     /* for(int i = 0; i < parameters.populations_count; ++i)
     {
         for(int j = 0; j < parameters.population_size; ++j)
         {
-            for(int k = 0; k < data.vertex_count; ++k)
+            for(int k = 0; k < graph.vertex_count; ++k)
             {
-                cout << generation.populations[i].chromosomes[j].genes[k] << ' ';
+                cout << generation.populations[i].chromosomes[j].labels[k] << ' ';
             }
 
             cout << '\t';
             cout << generation.populations[i].chromosomes[j].is_correct << ' ';
-            cout << generation.populations[i].chromosomes[j].conflicting_genes << ' ';
+            cout << generation.populations[i].chromosomes[j].conflicting_vertexes << ' ';
             cout << generation.populations[i].chromosomes[j].chromatic_number << ' ';
             cout << generation.populations[i].chromosomes[j].fitness << ' ';
 
@@ -636,19 +973,49 @@ void print_data(parameters& parameters, data& data, generation& generation)
         cout << endl;
     } */
 
-    for(int i = 0; i < data.vertex_count; ++i)
+    print_solution(output, graph, *generation.best_chromosome);
+
+    for(int i = 0; i < parameters.max_generations; i += ceil((double) parameters.max_generations / 100))
     {
-        cout << generation.best_chromosome->genes[i] << ' ';
+        output << generation.fitness_history[i] << ' ';
     }
-    cout << endl;
+}
 
-    cout << generation.best_chromosome->is_correct << endl;
-    cout << generation.best_chromosome->conflicting_genes << endl;
-    cout << generation.best_chromosome->chromatic_number << endl;
-    cout << generation.best_chromosome->fitness << endl;
+template<typename label_type>
+void release(parameters& parameters, generation<label_type>& g1, generation<label_type>& g2, archipelago<label_type>& archipelago)
+{
+    int chromosomes_count = parameters.populations_count * parameters.population_size;
 
-    for(int i = 0; i < parameters.max_generations; i += ceil((double) parameters.max_generations / 100))
+    free_solutions(g1.chromosomes, chromosomes_count);
+    free_solutions(g2.chromosomes, chromosomes_count);
+
+    delete[] g1.chromosomes;
+    delete[] g2.chromosomes;
+    delete[] g1.fitness;
+    delete[] g2.fitness;
+    delete[] g1.order;
+    delete[] g2.order;
+    delete[] g1.populations;
+    delete[] g2.populations;
+
+    /* the fitness history and the best solution are shared by the two generations */
+    delete[] g1.fitness_history;
+    free_solution(*g1.best_chromosome);
+    delete g1.best_chromosome;
+
+    free_solutions(archipelago.migrants, parameters.populations_count * archipelago.migrants_count);
+
+    delete[] archipelago.migrants;
+
+    for(int i = 0; i < parameters.populations_count; ++i)
     {
-        cout << generation.fitness_history[i] << ' ';
+        delete[] archipelago.islands[i].changed;
+        delete[] archipelago.islands[i].block;
+        delete[] archipelago.islands[i].visited;
     }
+
+    delete[] archipelago.islands;
+    delete[] archipelago.vertex_order;
+    delete[] archipelago.history;
+    delete archipelago.migration_barrier;
 }
@@ -0,0 +1,64 @@
+/*  Borsos Barna
+
+    INPUT
+        argv[1] - text input file path
+        argv[2] - binary graph file path
+
+    OUTPUT
+        line 1: vertex count
+        line 2: edge count
+        line 3: size of the binary graph file (bytes)
+
+    Builds the graph of a text input file and writes it as a binary graph
+    file (see labeling/graph_file.h), which the algorithms map in place
+    of the text file.
+*/
+
+#include <iostream>
+#include <stdexcept>
+
+#include "labeling/graph.h"
+#include "labeling/graph_file.h"
+
+using namespace std;
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        if(argc < 3)
+        {
+            throw invalid_argument("argc");
+        }
+
+        graph text_graph;
+        graph binary_graph;
+
+        load_graph(argv[1], text_graph);
+
+        /* map the written file back, it is checked the same way the algorithms check it */
+        if(!write_graph_file(argv[2], text_graph) || !map_graph_file(argv[2], binary_graph))
+        {
+            throw runtime_error(argv[2]);
+        }
+
+        cout << binary_graph.vertex_count << endl;
+        cout << binary_graph.edge_count << endl;
+        cout << binary_graph.mapping_size << endl;
+
+        free_graph(text_graph);
+        free_graph(binary_graph);
+    }
+    catch(input_error& error)
+    {
+        cout << "Error: invalid input file (line " << error.line << ")!" << endl;
+        return 1;
+    }
+    catch(...)
+    {
+        cout << "Error: check parameters!" << endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -3,12 +3,33 @@
     INPUT
         argv[1] - h (min. difference between neighbors)
         argv[2] - k (min. difference between second order neighbors)
-        argv[3] - file path
+        argv[3] - file path (text input file or binary graph file)
         argv[4] - max. label value
         argv[5] - initial temperature
         argv[6] - cooling factor
         argv[7] - max. iterations
-        argv[8] - max. running time (seconds)
+        argv[8] - max. running time (seconds, with millisecond resolution)
+
+        --chains n   - number of annealing chains run in parallel (default: 1)
+        --sync n     - iterations between two synchronizations of the chains (default: 0, independent chains)
+        --replicas n - number of replicas for replica exchange (parallel tempering, default: off)
+        --exchange n - iterations between two replica exchanges (default: EXCHANGE_INTERVAL)
+        --seed n     - seed of the random number generators (default: random)
+        --cache dir  - directory of the preprocessed graphs (default: no cache)
+        --stop-feasible 1 - stop at the first correct solution, the output then gives
+                       the time and the iterations needed (default: 0)
+        --progress 1 - write a progress record whenever the best solution improves,
+                       see labeling/progress.h (default: 0)
+        --stats 1    - write the statistics of the run after the output, with the accepted
+                       and rejected moves in every temperature band, see labeling/stats.h (default: 0)
+
+    DAEMON
+        argv[1] - --daemon
+        --workers n  - number of jobs solved in parallel (default: number of cores)
+        --cache dir  - directory of the preprocessed graphs (default: no cache)
+
+        Jobs with the arguments above are read from the standard input,
+        see labeling/daemon.h.
 
     OUTPUT
         line 1: time elapsed
@@ -19,132 +40,156 @@
         line 6: number of conflicting vertexes
         line 7: chromatic number
         line 8: fitness
+        line 9: statistics of the run (--stats 1)
+
+    Every chain starts from its own random solution on its own thread.
+    At a synchronization every chain continues from the best current
+    solution. The output describes the chain which found the best solution.
+
+    With replica exchange the chains keep fixed temperatures on a geometric
+    ladder from the initial temperature down to MIN_TEMPERATURE instead of
+    cooling. At every exchange the replicas at neighboring temperatures
+    swap their temperatures by the Metropolis criterion.
 */
 
 #include <iostream>
-#include <fstream>
 #include <cstdlib>
 #include <cstring>
 #include <ctime>
 #include <cmath>
 #include <algorithm>
+#include <atomic>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "labeling/graph.h"
+#include "labeling/solution.h"
+#include "labeling/evaluator.h"
+#include "labeling/graph_cache.h"
+#include "labeling/barrier.h"
+#include "labeling/daemon.h"
+#include "labeling/options.h"
+#include "labeling/progress.h"
+#include "labeling/random.h"
+#include "labeling/stats.h"
+#include "labeling/timer.h"
 
 using namespace std;
 
 #define MIN_TEMPERATURE 0.00001
+#define EXCHANGE_INTERVAL 100    // default iterations between two replica exchanges
+#define TIME_CHECK_INTERVAL 256  // iterations between two readings of the clock and two progress reports
+#define TEMPERATURE_BANDS 8      // decades of temperature below the initial one counted apart in the statistics
 
-struct parameters
+struct parameters : constraints
 {
-    int h;                      // min. difference between adjacent vertexes
-    int k;                      // min. difference between vertexes at distance of 2 edges
     char* file;                 // input file path
-    int max_label;              // max. value of a label
 
     double temperature;         // starting system temperature
     double cooling_factor;      // system cooling coefficient (0 < x < 1)
     int max_iterations;         // max. number of iterations
-    int max_time;               // max. running time (seconds)
-};
-
-struct data
-{
-    int vertex_count;           // number of vertexes
-    int edge_count;             // number of edges
-    int fixed_vertex_count;     // number of predefined vertexes
-
-    bool** graph;               // graph adjacency matrix
-    int** neighbors;            // array of adjacent vertexes for every vertex
-    int** second_neighbors;     // array of vertexes at distance of 2 edges for each vertex
-    int* solution_backbone;     // fixed vertexes of the solution
+    double max_time;            // max. running time (seconds)
+    double start_time;          // time the run started
+    deadline time_limit;        // end of the run
+
+    int chains;                 // number of annealing chains run in parallel
+    int sync_interval;          // iterations between two synchronizations (0: independent chains)
+    bool replica_exchange;      // chains are replicas on a fixed temperature ladder
+    bool stop_feasible;         // stop at the first correct solution
+    uint64_t seed;              // seed of the random number generators
+    const char* cache_path;     // directory of the preprocessed graphs (NULL: no cache)
+    progress progress_records;  // progress records of the run
+    stats run_stats;            // statistics of the run
 };
 
-struct solution
+struct move_stats
 {
-    int* data;                  // proposed solution
-
-    bool is_correct;            // solution correctness
-    int conflicting_vertexes;   // solution conflicting vertexes count
-    int chromatic_number;       // solution chromatic number
-    double fitness;             // solution fitness
+    int64_t accepted[TEMPERATURE_BANDS];    // accepted moves in every temperature band
+    int64_t rejected[TEMPERATURE_BANDS];    // rejected moves in every temperature band
+    int64_t improving;                      // accepted moves improving the fitness of the current solution
 };
 
+template<typename label_type>
 struct state
 {
     double temperature;         // current temperature
     int iteration;              // current iteration
+    random_generator generator; // random number generator of the chain
+    deadline time_limit;        // end of the run, asked by the chain
 
-    solution current_solution;  // current solution
-    solution next_solution;     // next proposed solution
-    solution best_solution;     // global best solution
-};
+    solution<label_type> current_solution;  // current solution
+    solution<label_type> best_solution;     // global best solution
+    bool best_is_current;                   // best solution labels are not copied yet from the current solution
+
+    int changed_vertex;         // vertex relabeled by the last proposed move
+    int previous_label;         // label of the changed vertex before the move
+    double previous_fitness;    // fitness of the current solution before the move
 
-void set_parameters(char**, parameters&);
-void initialize(parameters&, data&);
-void neighbors(data&);
-void second_neighbors(data&);
+    move_stats moves;           // moves of the chain (statistics)
+};
 
-void initialize(parameters&, data&, state&);
-bool is_correct(parameters&, data&, solution&);
-bool is_conflicting_vertex(parameters&, data&, solution&, int);
-int chromatic_number(parameters&, data&, solution&);
-double fitness(parameters&, data&, solution&);
+template<typename label_type>
+struct ensemble
+{
+    state<label_type>* states;  // state of every annealing chain
+    barrier* sync_barrier;      // chains wait here for each other before a synchronization
+    bool stop;                  // set at a synchronization when the run is over
+    atomic<bool> feasible;      // a chain found a correct solution (stop at the first correct solution)
+
+    int* ladder;                // chain at every temperature of the ladder, hottest first (replica exchange)
+    int exchange_round;         // number of replica exchanges done
+    random_generator generator; // random number generator of the exchanges
+};
 
-void generate_next_solution(parameters&,data&, state&);
-void cooling(parameters&, state&);
-void print_state(data&, state&);
+void set_parameters(int, char**, ostream&, parameters&);
+void solve(int, char**, graph&, ostream&, ostream&);
+void solve(parameters&, graph&, ostream&);
+template<typename label_type> void solve(parameters&, graph&, ostream&);
+template<typename label_type> void initialize(parameters&, graph&, state<label_type>&);
+template<typename label_type> void initialize(parameters&, ensemble<label_type>&);
+
+template<typename label_type> void anneal(parameters&, graph&, ensemble<label_type>&, int);
+template<typename label_type> void synchronize(parameters&, graph&, ensemble<label_type>&);
+template<typename label_type> void exchange(parameters&, ensemble<label_type>&);
+template<typename label_type> void iterate(parameters&, graph&, state<label_type>&);
+template<typename label_type> void generate_next_solution(parameters&, graph&, state<label_type>&);
+template<typename label_type> void update_best_solution(graph&, state<label_type>&);
+template<typename label_type> void keep_feasible_solution(state<label_type>&);
+template<typename label_type> void report_best_solution(parameters&, graph&, state<label_type>&);
+template<typename label_type> void cooling(parameters&, state<label_type>&);
+template<typename label_type> void count_move(parameters&, state<label_type>&, bool);
+template<typename label_type> string move_counters(parameters&, ensemble<label_type>&);
+template<typename label_type> void print_state(ostream&, parameters&, graph&, state<label_type>&);
+template<typename label_type> void release(parameters&, ensemble<label_type>&);
 
 int main(int argc, char** argv)
 {
+    if(argc > 1 && strcmp(argv[1], "--daemon") == 0)
+    {
+        return run_daemon(argc, argv, solve);
+    }
+
     try
     {
         parameters parameters;
-        data data;
-        state state;
-
-        srand(time(NULL));
+        graph graph;
 
-        set_parameters(argv, parameters);
-        initialize(parameters, data);
-        initialize(parameters, data, state);
+        set_parameters(argc, argv, cout, parameters);
+        load_graph_file(parameters.file, parameters.cache_path, graph);
 
-        while(state.iteration < parameters.max_iterations &&
-              clock() / CLOCKS_PER_SEC < parameters.max_time)
-        {
-            generate_next_solution(parameters, data, state);
-
-            /* update current solution if needed */
-            if(state.next_solution.fitness > state.current_solution.fitness || (double) rand() / RAND_MAX <
-               exp((state.next_solution.fitness - state.current_solution.fitness) / state.temperature))
-            {
-                for(int i = 0; i < data.vertex_count; ++i)
-                {
-                    state.current_solution.data[i] = state.next_solution.data[i];
-                }
-
-                state.current_solution.is_correct = state.next_solution.is_correct;
-                state.current_solution.conflicting_vertexes = state.next_solution.conflicting_vertexes;
-                state.current_solution.chromatic_number = state.next_solution.chromatic_number;
-                state.current_solution.fitness = state.next_solution.fitness;
-
-                /* update global best solution if needed */
-                if(state.current_solution.fitness > state.best_solution.fitness)
-                {
-                    for(int i = 0; i < data.vertex_count; ++i)
-                    {
-                        state.best_solution.data[i] = state.current_solution.data[i];
-                    }
-
-                    state.best_solution.is_correct = state.current_solution.is_correct;
-                    state.best_solution.conflicting_vertexes = state.current_solution.conflicting_vertexes;
-                    state.best_solution.chromatic_number = state.current_solution.chromatic_number;
-                    state.best_solution.fitness = state.current_solution.fitness;
-                }
-            }
+        /* a signal stops the run early, it still writes the best solution found */
+        cancel_on_signals();
 
-            cooling(parameters, state);
-        }
+        solve(parameters, graph, cout);
 
-        print_state(data, state);
+        free_graph(graph);
+    }
+    catch(input_error& error)
+    {
+        cout << "Error: invalid input file (line " << error.line << ")!" << endl;
+        return 1;
     }
     catch(...)
     {
@@ -155,346 +200,503 @@ int main(int argc, char** argv)
     return 0;
 }
 
-void set_parameters(char** argv, parameters& parameters)
+void set_parameters(int argc, char** argv, ostream& progress, parameters& parameters)
 {
+    if(argc < 9)
+    {
+        throw invalid_argument("argc");
+    }
+
+    parameters.start_time = current_time();
+
     /* store command line arguments in appropriate structures */
     parameters.h = atoi(argv[1]);
     parameters.k = atoi(argv[2]);
 
-    parameters.file = new char[strlen(argv[3]) + 1];
-    strcpy(parameters.file, argv[3]);
+    parameters.file = argv[3];
 
     parameters.max_label = atoi(argv[4]);
     parameters.temperature = atof(argv[5]);
     parameters.cooling_factor = atof(argv[6]);
     parameters.max_iterations = atoi(argv[7]);
-    parameters.max_time = atoi(argv[8]);
+    parameters.max_time = atof(argv[8]);
+    set_deadline(parameters.time_limit, parameters.start_time, parameters.max_time, TIME_CHECK_INTERVAL);
+
+    const char* seed = get_option(argc, argv, 9, "seed");
+    parameters.seed = seed ? strtoull(seed, NULL, 10) : random_seed();
+    parameters.cache_path = get_option(argc, argv, 9, "cache");
+    parameters.stop_feasible = get_option(argc, argv, 9, "stop-feasible", 0) != 0;
+    start_progress(parameters.progress_records, get_option(argc, argv, 9, "progress", 0) ? &progress : NULL);
+    start_stats(parameters.run_stats, get_option(argc, argv, 9, "stats", 0) != 0, parameters.start_time);
+
+    parameters.chains = max(1, get_option(argc, argv, 9, "chains", 1));
+    parameters.sync_interval = max(0, get_option(argc, argv, 9, "sync", 0));
+
+    /* replica exchange runs one chain for every replica and exchanges at the synchronizations */
+    int replicas = get_option(argc, argv, 9, "replicas", 0);
+    parameters.replica_exchange = replicas > 1;
+
+    if(parameters.replica_exchange)
+    {
+        parameters.chains = replicas;
+        parameters.sync_interval = max(1, get_option(argc, argv, 9, "exchange", EXCHANGE_INTERVAL));
+    }
 }
 
-void initialize(parameters& parameters, data& data)
+void solve(int argc, char** argv, graph& graph, ostream& output, ostream& progress)
 {
-    /* read data from file */
-    fstream file(parameters.file, ios_base::in);
+    /* a daemon job, the graph is already loaded */
+    parameters parameters;
 
-    file >> data.vertex_count;
-    file >> data.edge_count;
-    file >> data.fixed_vertex_count;
+    set_parameters(argc, argv, progress, parameters);
+    solve(parameters, graph, output);
+}
+
+void solve(parameters& parameters, graph& graph, ostream& output)
+{
+    end_phase(parameters.run_stats, LOAD_PHASE);
+    check_fixed_labels(parameters, graph);
 
-    /* allocate memory for adjacency matrix */
-    data.graph = new bool*[data.vertex_count];
-    for(int i = 0; i < data.vertex_count; ++i)
+    /* store the labels in the narrowest type holding max. label */
+    if(parameters.max_label <= UINT8_MAX)
     {
-        data.graph[i] = new bool[data.vertex_count]();
+        solve<uint8_t>(parameters, graph, output);
     }
+    else if(parameters.max_label <= UINT16_MAX)
+    {
+        solve<uint16_t>(parameters, graph, output);
+    }
+    else
+    {
+        solve<int>(parameters, graph, output);
+    }
+}
 
-    /* fill adjacency matrix */
-    int vertex1, vertex2;
-    for(int i = 0; i < data.edge_count; ++i)
+template<typename label_type>
+void solve(parameters& parameters, graph& graph, ostream& output)
+{
+    ensemble<label_type> ensemble;
+
+    ensemble.states = new state<label_type>[parameters.chains];
+    ensemble.sync_barrier = new barrier(parameters.chains);
+    ensemble.stop = false;
+    ensemble.feasible = false;
+
+    for(int i = 0; i < parameters.chains; ++i)
     {
-        file >> vertex1 >> vertex2;
-        --vertex1; --vertex2;
+        seed_generator(ensemble.states[i].generator, parameters.seed, i);
+        initialize(parameters, graph, ensemble.states[i]);
 
-        data.graph[vertex1][vertex2] = true;
-        data.graph[vertex2][vertex1] = true;
+        /* the initial solution may already be correct */
+        if(parameters.stop_feasible && ensemble.states[i].current_solution.is_correct)
+        {
+            ensemble.feasible = true;
+        }
     }
 
-    /* create solution backbone */
-    data.solution_backbone = new int[data.vertex_count]();
-    int vertex, value;
-    for (int i = 0; i < data.fixed_vertex_count; ++i)
+    if(parameters.replica_exchange)
     {
-        file >> vertex >> value;
-        data.solution_backbone[--vertex] = value;
+        initialize(parameters, ensemble);
     }
 
-    /* close file */
-    file.close();
+    end_phase(parameters.run_stats, PREPROCESS_PHASE);
 
-    neighbors(data);
-    second_neighbors(data);
-}
+    /* run every chain on its own thread */
+    vector<thread> threads;
 
-void neighbors(data& data)
-{
-    /* allocate memory for every vertex */
-    data.neighbors = new int*[data.vertex_count];
+    for(int i = 0; i < parameters.chains; ++i)
+    {
+        threads.push_back(thread(anneal<label_type>, ref(parameters), ref(graph), ref(ensemble), i));
+    }
 
-    /* for every vertex */
-    for(int i = 0; i < data.vertex_count; ++i)
+    for(size_t i = 0; i < threads.size(); ++i)
     {
-        /* calculate neighbors count */
-        int neighbors_count = 0;
-        for(int j = 0; j < data.vertex_count; ++j)
-        {
-            if(data.graph[i][j])
-            {
-                ++neighbors_count;
-            }
-        }
+        threads[i].join();
+    }
 
-        /* allocate memory for neighbors */
-        data.neighbors[i] = new int[neighbors_count + 1];
+    end_phase(parameters.run_stats, SEARCH_PHASE);
+
+    /* report the chain with the best solution, a correct one when stopped at the first correct solution */
+    int best_chain = 0;
+
+    for(int i = 1; i < parameters.chains; ++i)
+    {
+        solution<label_type>& chain_best = ensemble.states[i].best_solution;
+        solution<label_type>& best = ensemble.states[best_chain].best_solution;
 
-        /* fill neighbors */
-        int index = 0;
-        data.neighbors[i][0] = neighbors_count;
+        bool better = chain_best.fitness > best.fitness;
 
-        for(int j = 0; j < data.vertex_count; ++j)
+        if(parameters.stop_feasible && chain_best.is_correct != best.is_correct)
         {
-            if(data.graph[i][j])
-            {
-                data.neighbors[i][++index] = j;
-            }
+            better = chain_best.is_correct;
+        }
+
+        if(better)
+        {
+            best_chain = i;
         }
     }
+
+    print_state(output, parameters, graph, ensemble.states[best_chain]);
+
+    if(parameters.run_stats.enabled)
+    {
+        write_stats(output, parameters.run_stats, move_counters(parameters, ensemble));
+    }
+
+    release(parameters, ensemble);
+}
+
+template<typename label_type>
+void initialize(parameters& parameters, graph& graph, state<label_type>& state)
+{
+    state.temperature = parameters.temperature;
+    state.iteration = 0;
+    state.time_limit = parameters.time_limit;
+    state.moves = move_stats();
+
+    allocate_solution(parameters, graph, state.current_solution, true);
+    random_solution(parameters, graph, state.current_solution, state.generator);
+    evaluate(parameters, graph, state.current_solution);
+
+    /* the best solution only needs its own labels once the current solution moves away from it */
+    allocate_solution(parameters, graph, state.best_solution, false);
+    copy_evaluation(state.current_solution, state.best_solution);
+    state.best_is_current = true;
+}
+
+template<typename label_type>
+void initialize(parameters& parameters, ensemble<label_type>& ensemble)
+{
+    ensemble.ladder = new int[parameters.chains];
+    ensemble.exchange_round = 0;
+    seed_generator(ensemble.generator, parameters.seed, parameters.chains);
+
+    /* geometric temperature ladder from the initial temperature down to the min. temperature */
+    double ratio = pow(MIN_TEMPERATURE / parameters.temperature, 1.0 / (parameters.chains - 1));
+
+    for(int i = 0; i < parameters.chains; ++i)
+    {
+        ensemble.ladder[i] = i;
+        ensemble.states[i].temperature = max(MIN_TEMPERATURE, parameters.temperature * pow(ratio, i));
+    }
 }
 
-void second_neighbors(data& data)
+template<typename label_type>
+void anneal(parameters& parameters, graph& graph, ensemble<label_type>& ensemble, int index)
 {
-    /* allocate memory for every vertex */
-    data.second_neighbors = new int*[data.vertex_count];
+    state<label_type>& state = ensemble.states[index];
+
+    /* with every vertex predefined there is no move, the initial solution is the result */
+    if(graph.fixed_vertex_count == graph.vertex_count)
+    {
+        return;
+    }
 
-    for(int i = 0; i < data.vertex_count; ++i)
+    while(!ensemble.stop)
     {
-        /* calculate second neighbors count */
-        int second_neighbors_count = 0;
+        /* run the chain alone until the next synchronization */
+        int last_iteration = parameters.max_iterations;
 
-        for(int j = 1; j <= data.neighbors[i][0]; ++j)
+        if(parameters.sync_interval)
         {
-            second_neighbors_count += data.neighbors[data.neighbors[i][j]][0];
+            last_iteration = min(last_iteration, state.iteration + parameters.sync_interval);
         }
 
-        /* allocate memory for initial second neighbors */
-        int* second_neighbors = new int[second_neighbors_count + 1];
-
-        /* fill second neighbors */
-        int index = 0;
-        second_neighbors[0] = second_neighbors_count;
-
-        for(int j = 1; j <= data.neighbors[i][0]; ++j)
+        while(state.iteration < last_iteration && !time_is_up(state.time_limit) && !ensemble.feasible)
         {
-            for(int k = 1; k <= data.neighbors[data.neighbors[i][j]][0]; ++k)
+            iterate(parameters, graph, state);
+
+            if(parameters.stop_feasible && state.current_solution.is_correct)
             {
-                second_neighbors[++index] = data.neighbors[data.neighbors[i][j]][k];
+                keep_feasible_solution(state);
+                ensemble.feasible = true;
             }
-        }
-
-        /* make second neighbors list a set */
-        int final_count = 0;
-        sort(second_neighbors + 1, second_neighbors + second_neighbors_count + 1);
 
-        for(int j = 1; j <= second_neighbors_count; ++j)
-        {
-            if(second_neighbors[j] != i)
+            if(state.iteration % TIME_CHECK_INTERVAL == 0)
             {
-                if(j == 1)
-                {
-                    ++final_count;
-                }
-                else if(second_neighbors[j] != second_neighbors[j - 1])
-                {
-                    ++final_count;
-                }
+                report_best_solution(parameters, graph, state);
             }
         }
 
-        /* allocate memory for final second neighbors */
-        data.second_neighbors[i] = new int[final_count + 1];
-
-        index = 0;
-        data.second_neighbors[i][0] = final_count;
+        if(parameters.sync_interval == 0)
+        {
+            return;
+        }
 
-        for(int j = 1; j <= second_neighbors_count; ++j)
+        ensemble.sync_barrier->arrive_and_wait([&]
         {
-            if(second_neighbors[j] != i)
+            /* every chain did the same number of iterations unless the time is up */
+            if(state.iteration >= parameters.max_iterations || is_expired(state.time_limit) || ensemble.feasible)
             {
-                if(j == 1)
-                {
-                    data.second_neighbors[i][++index] = second_neighbors[j];
-                }
-                else if(second_neighbors[j] != second_neighbors[j - 1])
-                {
-                    data.second_neighbors[i][++index] = second_neighbors[j];
-                }
+                ensemble.stop = true;
             }
-        }
-
-        delete[] second_neighbors;
+            else if(parameters.replica_exchange)
+            {
+                exchange(parameters, ensemble);
+            }
+            else
+            {
+                synchronize(parameters, graph, ensemble);
+            }
+        });
     }
 }
 
-void initialize(parameters& parameters, data& data, state& state)
+template<typename label_type>
+void synchronize(parameters& parameters, graph& graph, ensemble<label_type>& ensemble)
 {
-    state.temperature = parameters.temperature;
-    state.iteration = 0;
-
-    state.current_solution.data = new int[data.vertex_count];
+    /* find the chain with the best current solution */
+    int best_chain = 0;
 
-    for(int i = 0; i < data.vertex_count; ++i)
+    for(int i = 1; i < parameters.chains; ++i)
     {
-        if (data.solution_backbone[i])
-        {
-            state.current_solution.data[i] = data.solution_backbone[i];
-        }
-        else
+        if(ensemble.states[i].current_solution.fitness > ensemble.states[best_chain].current_solution.fitness)
         {
-            state.current_solution.data[i] = rand() % parameters.max_label + 1;
+            best_chain = i;
         }
     }
 
-    state.current_solution.is_correct = is_correct(parameters, data, state.current_solution);
-    state.current_solution.chromatic_number = chromatic_number(parameters, data, state.current_solution);
-    state.current_solution.fitness = fitness(parameters, data, state.current_solution);
+    /* continue every other chain from it, keeping their own best solutions */
+    for(int i = 0; i < parameters.chains; ++i)
+    {
+        state<label_type>& state = ensemble.states[i];
+
+        if(i == best_chain)
+        {
+            continue;
+        }
 
-    /* copy initial solution */
-    state.next_solution = state.current_solution;
-    state.best_solution = state.current_solution;
+        if(state.best_is_current)
+        {
+            copy(state.current_solution.labels, state.current_solution.labels + graph.vertex_count, state.best_solution.labels);
+            state.best_is_current = false;
+        }
 
-    state.next_solution.data = new int[data.vertex_count];
-    state.best_solution.data = new int[data.vertex_count];
+        copy_tracked_solution(parameters, graph, ensemble.states[best_chain].current_solution, state.current_solution);
 
-    for(int i = 0; i < data.vertex_count; ++i)
-    {
-        state.next_solution.data[i] = state.current_solution.data[i];
-        state.best_solution.data[i] = state.current_solution.data[i];
+        if(state.current_solution.fitness > state.best_solution.fitness)
+        {
+            copy_evaluation(state.current_solution, state.best_solution);
+            state.best_is_current = true;
+        }
     }
 }
 
-bool is_correct(parameters& parameters, data& data, solution& solution)
+template<typename label_type>
+void exchange(parameters& parameters, ensemble<label_type>& ensemble)
 {
-    bool correctness = true;
-    solution.conflicting_vertexes = 0;
-
-    for(int i = 0; i < data.vertex_count; ++i)
+    /* alternate between the even and the odd pairs of neighboring temperatures */
+    for(int i = ensemble.exchange_round++ % 2; i + 1 < parameters.chains; i += 2)
     {
-        if(is_conflicting_vertex(parameters, data, solution, i))
+        state<label_type>& hotter = ensemble.states[ensemble.ladder[i]];
+        state<label_type>& colder = ensemble.states[ensemble.ladder[i + 1]];
+
+        double delta = (colder.current_solution.fitness - hotter.current_solution.fitness) *
+                       (1 / hotter.temperature - 1 / colder.temperature);
+
+        if(delta >= 0 || random_double(ensemble.generator) < exp(delta))
         {
-            if(data.solution_backbone[i] == 0)
-            {
-                ++solution.conflicting_vertexes;
-            }
-            correctness = false;
+            swap(hotter.temperature, colder.temperature);
+            swap(ensemble.ladder[i], ensemble.ladder[i + 1]);
         }
     }
-
-    return correctness;
 }
 
-bool is_conflicting_vertex(parameters& parameters, data& data, solution& solution, int vertex)
+template<typename label_type>
+void iterate(parameters& parameters, graph& graph, state<label_type>& state)
 {
-    /* check neighbors */
-    for(int i = 1; i <= data.neighbors[vertex][0]; ++i)
+    generate_next_solution(parameters, graph, state);
+
+    /* keep the move if it is better or passes the acceptance test, undo it otherwise */
+    if(state.current_solution.fitness > state.previous_fitness || random_double(state.generator) <
+       exp((state.current_solution.fitness - state.previous_fitness) / state.temperature))
     {
-        if(abs(solution.data[vertex] - solution.data[data.neighbors[vertex][i]]) < parameters.h)
+        if(parameters.run_stats.enabled)
         {
-            return true;
+            count_move(parameters, state, true);
         }
-    }
 
-    /* check second neighbors */
-    for(int i = 1; i <= data.second_neighbors[vertex][0]; ++i)
+        update_best_solution(graph, state);
+    }
+    else
     {
-        if(abs(solution.data[vertex] - solution.data[data.second_neighbors[vertex][i]]) < parameters.k)
+        if(parameters.run_stats.enabled)
         {
-            return true;
+            count_move(parameters, state, false);
         }
+
+        relabel(parameters, graph, state.current_solution, state.changed_vertex, state.previous_label);
     }
 
-    return false;
+    cooling(parameters, state);
 }
 
-int chromatic_number(parameters& parameters, data& data, solution& solution)
+template<typename label_type>
+void generate_next_solution(parameters& parameters, graph& graph, state<label_type>& state)
 {
-    int max_label = solution.data[0];
+    /* change a random conflicting vertex to a random label */
+    if(state.current_solution.conflicting_vertexes)
+    {
+        state.changed_vertex = random_conflicting_vertex(state.current_solution, state.generator);
+    }
+    else
+    {
+        state.changed_vertex = graph.free_vertexes[random_int(state.generator, graph.vertex_count - graph.fixed_vertex_count)];
+    }
+
+    state.previous_label = state.current_solution.labels[state.changed_vertex];
+    state.previous_fitness = state.current_solution.fitness;
+
+    relabel(parameters, graph, state.current_solution, state.changed_vertex, random_int(state.generator, parameters.max_label) + 1);
+}
 
-    for(int i = 1; i < data.vertex_count; ++i)
+template<typename label_type>
+void update_best_solution(graph& graph, state<label_type>& state)
+{
+    solution<label_type>& current = state.current_solution;
+    solution<label_type>& best = state.best_solution;
+
+    if(current.fitness > best.fitness || (state.best_is_current && current.fitness == best.fitness))
     {
-        if(solution.data[i] > max_label)
-        {
-            max_label = solution.data[i];
-        }
+        copy_evaluation(current, best);
+        state.best_is_current = true;
     }
+    else if(state.best_is_current)
+    {
+        /* the accepted move left the best solution, save the labels it had before the move */
+        copy(current.labels, current.labels + graph.vertex_count, best.labels);
+        best.labels[state.changed_vertex] = state.previous_label;
 
-    return max_label;
+        state.best_is_current = false;
+    }
 }
 
-double fitness(parameters& parameters, data& data, solution& solution)
+template<typename label_type>
+void keep_feasible_solution(state<label_type>& state)
 {
-    return (4 * (1 - (double)solution.conflicting_vertexes / data.vertex_count) + (1 - (double)solution.chromatic_number / parameters.max_label)) / 5;
+    /* the first correct solution is the output, even if an incorrect one had a better fitness */
+    if(!state.best_solution.is_correct)
+    {
+        copy_evaluation(state.current_solution, state.best_solution);
+        state.best_is_current = true;
+    }
 }
 
-void generate_next_solution(parameters& parameters, data& data, state& state)
+template<typename label_type>
+void report_best_solution(parameters& parameters, graph& graph, state<label_type>& state)
 {
-    /* copy current solution to next solution */
-    for(int i = 0; i < data.vertex_count; ++i)
+    /* a progress record is only written if the best solution improved since the last one */
+    if(state.best_is_current)
+    {
+        report_progress(parameters.progress_records, parameters.start_time, state.iteration, graph, state.current_solution);
+    }
+    else
     {
-        state.next_solution.data[i] = state.current_solution.data[i];
+        report_progress(parameters.progress_records, parameters.start_time, state.iteration, graph, state.best_solution);
     }
-    state.next_solution.is_correct = state.current_solution.is_correct;
-    state.next_solution.conflicting_vertexes = state.current_solution.conflicting_vertexes;
-    state.next_solution.chromatic_number = state.current_solution.chromatic_number;
-    state.next_solution.fitness = state.current_solution.fitness;
+}
 
-    /* change a random conflicting vertex to a random label */
-    int random_vertex;
-    if(state.next_solution.conflicting_vertexes)
+template<typename label_type>
+void cooling(parameters& parameters, state<label_type>& state)
+{
+    ++state.iteration;
+
+    /* replicas keep their temperatures from the ladder */
+    if(parameters.replica_exchange)
+    {
+        return;
+    }
+
+    state.temperature *= parameters.cooling_factor;
+    if(state.temperature < MIN_TEMPERATURE)
+    {
+        state.temperature = MIN_TEMPERATURE;
+    }
+}
+
+template<typename label_type>
+void count_move(parameters& parameters, state<label_type>& state, bool accepted)
+{
+    /* decades of temperature below the initial temperature, the last band holds the colder ones */
+    int band = min(TEMPERATURE_BANDS - 1, max(0, (int) log10(parameters.temperature / state.temperature)));
+
+    if(accepted)
     {
-        random_vertex = rand() % state.next_solution.conflicting_vertexes;
+        ++state.moves.accepted[band];
 
-        for(int i = 0; i < data.vertex_count; ++i)
+        if(state.current_solution.fitness > state.previous_fitness)
         {
-            if(0 == data.solution_backbone[i] &&
-               is_conflicting_vertex(parameters, data, state.next_solution, i) &&
-               0 == random_vertex--)
-            {
-                state.next_solution.data[i] = rand() % parameters.max_label + 1;
-                break;
-            }
+            ++state.moves.improving;
         }
     }
     else
     {
-        random_vertex = rand() % (data.vertex_count - data.fixed_vertex_count);
+        ++state.moves.rejected[band];
+    }
+}
+
+template<typename label_type>
+string move_counters(parameters& parameters, ensemble<label_type>& ensemble)
+{
+    /* the moves of all chains together */
+    move_stats moves = move_stats();
 
-        for(int i = 0; i < data.vertex_count; ++i)
+    for(int i = 0; i < parameters.chains; ++i)
+    {
+        for(int j = 0; j < TEMPERATURE_BANDS; ++j)
         {
-            if(0 == data.solution_backbone[i] && 0 == random_vertex--)
-            {
-                state.next_solution.data[i] = rand() % parameters.max_label + 1;
-                break;
-            }
+            moves.accepted[j] += ensemble.states[i].moves.accepted[j];
+            moves.rejected[j] += ensemble.states[i].moves.rejected[j];
         }
+
+        moves.improving += ensemble.states[i].moves.improving;
     }
 
-    state.next_solution.is_correct = is_correct(parameters, data, state.next_solution);
-    state.next_solution.chromatic_number = chromatic_number(parameters, data, state.next_solution);
-    state.next_solution.fitness = fitness(parameters, data, state.next_solution);
+    /* every band is given by its highest temperature */
+    ostringstream counters;
+    counters << "\"temperatureBands\":[";
+
+    for(int j = 0; j < TEMPERATURE_BANDS; ++j)
+    {
+        counters << (j ? "," : "") << "{\"temperature\":" << json_number(parameters.temperature * pow(10, -j));
+        counters << ",\"accepted\":" << moves.accepted[j] << ",\"rejected\":" << moves.rejected[j] << '}';
+    }
+
+    counters << "],\"improvingMoves\":" << moves.improving;
+
+    return counters.str();
 }
 
-void cooling(parameters& parameters, state& state)
+template<typename label_type>
+void print_state(ostream& output, parameters& parameters, graph& graph, state<label_type>& state)
 {
-    ++state.iteration;
-    state.temperature *= parameters.cooling_factor;
-    if(state.temperature < MIN_TEMPERATURE)
+    if(state.best_is_current)
     {
-        state.temperature = MIN_TEMPERATURE;
+        copy(state.current_solution.labels, state.current_solution.labels + graph.vertex_count, state.best_solution.labels);
     }
+
+    output << elapsed_time(parameters.start_time) << endl;
+    output << state.iteration << endl;
+    output << state.temperature << endl;
+
+    print_solution(output, graph, state.best_solution);
 }
 
-void print_state(data& data, state& state)
+template<typename label_type>
+void release(parameters& parameters, ensemble<label_type>& ensemble)
 {
-    cout << (double) clock() / CLOCKS_PER_SEC << endl;
-    cout << state.iteration << endl;
-    cout << state.temperature << endl;
+    for(int i = 0; i < parameters.chains; ++i)
+    {
+        free_solution(ensemble.states[i].current_solution);
+        free_solution(ensemble.states[i].best_solution);
+    }
 
-    for(int i = 0; i < data.vertex_count; ++i)
+    if(parameters.replica_exchange)
     {
-        cout << state.best_solution.data[i] << ' ';
+        delete[] ensemble.ladder;
     }
-    cout << endl;
 
-    cout << state.best_solution.is_correct << endl;
-    cout << state.best_solution.conflicting_vertexes << endl;
-    cout << state.best_solution.chromatic_number << endl;
-    cout << state.best_solution.fitness << endl;
+    delete[] ensemble.states;
+    delete ensemble.sync_barrier;
 }
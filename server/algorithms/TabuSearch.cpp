@@ -0,0 +1,589 @@
+/*  Borsos Barna
+
+    INPUT
+        argv[1] - h (min. difference between neighbors)
+        argv[2] - k (min. difference between second order neighbors)
+        argv[3] - file path (text input file or binary graph file)
+        argv[4] - max. label value
+        argv[5] - tabu tenure (max. random part of it)
+        argv[6] - max. iterations
+        argv[7] - max. running time (seconds, with millisecond resolution)
+
+        --seed n     - seed of the random number generator (default: random)
+        --cache dir  - directory of the preprocessed graphs (default: no cache)
+        --stop-feasible 1 - stop at the first correct solution, the output then gives
+                       the time and the iterations needed (default: 0)
+        --progress 1 - write a progress record whenever the best solution improves,
+                       see labeling/progress.h (default: 0)
+        --stats 1    - write the statistics of the run after the output, with the improving
+                       moves and the span reductions, see labeling/stats.h (default: 0)
+
+    DAEMON
+        argv[1] - --daemon
+        --workers n  - number of jobs solved in parallel (default: number of cores)
+        --cache dir  - directory of the preprocessed graphs (default: no cache)
+
+        Jobs with the arguments above are read from the standard input,
+        see labeling/daemon.h.
+
+    OUTPUT
+        line 1: time elapsed
+        line 2: iterations done
+        line 3: iteration of the best solution
+        line 4: solution found
+        line 5: solution correctness
+        line 6: number of conflicting vertexes
+        line 7: chromatic number
+        line 8: fitness
+        line 9: statistics of the run (--stats 1)
+
+    Every iteration moves a conflicting vertex to the label which removes
+    the most violated constraints. The violated constraints of every vertex
+    with every label are kept in a table, updated at every move over the
+    constraint vertexes of the moved vertex, so a move is rated in constant
+    time. Moving a vertex back to the label it left is tabu for the tabu
+    tenure (a random part plus TENURE_FACTOR times the conflicting vertexes),
+    unless the move leads to fewer violated constraints than found before
+    (aspiration).
+
+    Once every violated constraint is between predefined vertexes or on a
+    loop (which no move changes) the greatest label is taken away and the search goes
+    on with the labels above it changed to random ones. The best solution
+    is the fittest one of those with the fewest conflicting vertexes.
+
+    The search starts with the span a greedy labeling could need at most,
+    if it is smaller than max. label, which also bounds the size of the
+    tables. A single vertex of high degree makes that bound close to max.
+    label for every vertex, so the tables are also kept to MAX_TABLE_SIZE
+    entries by starting with a smaller span. A run whose predefined labels
+    alone need larger tables is rejected.
+*/
+
+#include <iostream>
+#include <cstdlib>
+#include <cstring>
+#include <climits>
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+
+#include "labeling/graph.h"
+#include "labeling/solution.h"
+#include "labeling/evaluator.h"
+#include "labeling/graph_cache.h"
+#include "labeling/daemon.h"
+#include "labeling/options.h"
+#include "labeling/progress.h"
+#include "labeling/random.h"
+#include "labeling/stats.h"
+#include "labeling/timer.h"
+
+using namespace std;
+
+#define TENURE_FACTOR 0.6        // tabu iterations added for every conflicting vertex
+#define TIME_CHECK_INTERVAL 16   // iterations between two readings of the clock and two progress reports
+#define MAX_TABLE_SIZE (1 << 27) // max. entries of a table (vertexes times labels)
+
+struct parameters : constraints
+{
+    char* file;                 // input file path
+
+    int tabu_tenure;            // max. random part of the tabu tenure
+    int max_iterations;         // max. number of iterations
+    double max_time;            // max. running time (seconds)
+    double start_time;          // time the run started
+    deadline time_limit;        // end of the run
+
+    bool stop_feasible;         // stop at the first correct solution
+    uint64_t seed;              // seed of the random number generator
+    const char* cache_path;     // directory of the preprocessed graphs (NULL: no cache)
+    progress progress_records;  // progress records of the run
+    stats run_stats;            // statistics of the run
+};
+
+template<typename label_type>
+struct state
+{
+    int iteration;              // current iteration
+    int best_iteration;         // iteration the best solution was found at
+    int span;                   // greatest label of the moves
+    int violations;             // violated constraints of the current solution, not between predefined vertexes or loops
+    int best_violations;        // fewest violated constraints found with the current span
+    random_generator generator; // random number generator of the search
+
+    solution<label_type> current_solution;  // current solution
+    solution<label_type> best_solution;     // best solution found
+
+    int separation[4];          // required separation of a constraint vertex, indexed by its distance tags
+    int width;                  // labels of a vertex in the tables (greatest label + 1)
+    int* label_conflicts;       // violated constraints of every vertex with every label
+    int* tabu;                  // iteration until the move of every vertex to every label is tabu
+
+    int64_t improving_moves;    // moves decreasing the violated constraints (statistics)
+    int span_reductions;        // spans reduced after a solution without violated constraints (statistics)
+};
+
+void set_parameters(int, char**, ostream&, parameters&);
+void solve(int, char**, graph&, ostream&, ostream&);
+void solve(parameters&, graph&, ostream&);
+template<typename label_type> void solve(parameters&, graph&, ostream&);
+template<typename label_type> void initialize(parameters&, graph&, state<label_type>&);
+
+template<typename label_type> void tabu_search(parameters&, graph&, state<label_type>&);
+template<typename label_type> bool select_move(state<label_type>&, int&, int&);
+template<typename label_type> void apply_move(parameters&, graph&, state<label_type>&, int, int);
+template<typename label_type> bool reduce_span(parameters&, graph&, state<label_type>&);
+template<typename label_type> void update_best_solution(graph&, state<label_type>&);
+template<typename label_type> void print_state(ostream&, parameters&, graph&, state<label_type>&);
+template<typename label_type> void release(state<label_type>&);
+
+int main(int argc, char** argv)
+{
+    if(argc > 1 && strcmp(argv[1], "--daemon") == 0)
+    {
+        return run_daemon(argc, argv, solve);
+    }
+
+    try
+    {
+        parameters parameters;
+        graph graph;
+
+        set_parameters(argc, argv, cout, parameters);
+        load_graph_file(parameters.file, parameters.cache_path, graph);
+
+        /* a signal stops the run early, it still writes the best solution found */
+        cancel_on_signals();
+
+        solve(parameters, graph, cout);
+
+        free_graph(graph);
+    }
+    catch(input_error& error)
+    {
+        cout << "Error: invalid input file (line " << error.line << ")!" << endl;
+        return 1;
+    }
+    catch(...)
+    {
+        cout << "Error: check parameters!" << endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+void set_parameters(int argc, char** argv, ostream& progress, parameters& parameters)
+{
+    if(argc < 8)
+    {
+        throw invalid_argument("argc");
+    }
+
+    parameters.start_time = current_time();
+
+    /* store command line arguments in appropriate structures */
+    parameters.h = atoi(argv[1]);
+    parameters.k = atoi(argv[2]);
+
+    parameters.file = argv[3];
+
+    parameters.max_label = atoi(argv[4]);
+    parameters.tabu_tenure = atoi(argv[5]);
+    parameters.max_iterations = atoi(argv[6]);
+    parameters.max_time = atof(argv[7]);
+    set_deadline(parameters.time_limit, parameters.start_time, parameters.max_time, TIME_CHECK_INTERVAL);
+
+    if(parameters.max_label < 1 || parameters.tabu_tenure < 0)
+    {
+        throw invalid_argument("argv");
+    }
+
+    const char* seed = get_option(argc, argv, 8, "seed");
+    parameters.seed = seed ? strtoull(seed, NULL, 10) : random_seed();
+    parameters.cache_path = get_option(argc, argv, 8, "cache");
+    parameters.stop_feasible = get_option(argc, argv, 8, "stop-feasible", 0) != 0;
+    start_progress(parameters.progress_records, get_option(argc, argv, 8, "progress", 0) ? &progress : NULL);
+    start_stats(parameters.run_stats, get_option(argc, argv, 8, "stats", 0) != 0, parameters.start_time);
+}
+
+void solve(int argc, char** argv, graph& graph, ostream& output, ostream& progress)
+{
+    /* a daemon job, the graph is already loaded */
+    parameters parameters;
+
+    set_parameters(argc, argv, progress, parameters);
+    solve(parameters, graph, output);
+}
+
+void solve(parameters& parameters, graph& graph, ostream& output)
+{
+    end_phase(parameters.run_stats, LOAD_PHASE);
+    check_fixed_labels(parameters, graph);
+
+    /* store the labels in the narrowest type holding max. label */
+    if(parameters.max_label <= UINT8_MAX)
+    {
+        solve<uint8_t>(parameters, graph, output);
+    }
+    else if(parameters.max_label <= UINT16_MAX)
+    {
+        solve<uint16_t>(parameters, graph, output);
+    }
+    else
+    {
+        solve<int>(parameters, graph, output);
+    }
+}
+
+template<typename label_type>
+void solve(parameters& parameters, graph& graph, ostream& output)
+{
+    state<label_type> state;
+
+    seed_generator(state.generator, parameters.seed, 0);
+    initialize(parameters, graph, state);
+    end_phase(parameters.run_stats, PREPROCESS_PHASE);
+
+    tabu_search(parameters, graph, state);
+    end_phase(parameters.run_stats, SEARCH_PHASE);
+
+    print_state(output, parameters, graph, state);
+
+    if(parameters.run_stats.enabled)
+    {
+        ostringstream counters;
+        counters << "\"improvingMoves\":" << state.improving_moves << ",\"spanReductions\":" << state.span_reductions;
+
+        write_stats(output, parameters.run_stats, counters.str());
+    }
+
+    release(state);
+}
+
+template<typename label_type>
+void initialize(parameters& parameters, graph& graph, state<label_type>& state)
+{
+    state.iteration = 0;
+    state.best_iteration = 0;
+    state.improving_moves = 0;
+    state.span_reductions = 0;
+
+    separations(parameters, state.separation);
+
+    /* a vertex has at most this many labels violating a constraint, so a correct labeling never needs more labels */
+    int max_blocked = 0;
+
+    for(int i = 0; i < graph.vertex_count; ++i)
+    {
+        int blocked = 0;
+
+        for(int j = graph.constraint_offsets[i]; j < graph.constraint_offsets[i + 1]; ++j)
+        {
+            blocked += max(0, 2 * state.separation[graph.constraint_vertexes[j] >> CONSTRAINT_DISTANCE_SHIFT] - 1);
+        }
+
+        max_blocked = max(max_blocked, blocked);
+    }
+
+    /* the moves keep to the span, the tables only need the labels up to it and the predefined ones */
+    state.span = min(parameters.max_label, max_blocked + 1);
+
+    /* the tables are kept to a bound that does not depend on the degrees */
+    int max_width = MAX_TABLE_SIZE / graph.vertex_count;
+
+    if(max(1, graph.max_fixed_label) + 1 > max_width)
+    {
+        throw invalid_argument("max. label");
+    }
+
+    state.span = min(state.span, max_width - 1);
+    state.width = max(state.span, graph.max_fixed_label) + 1;
+
+    constraints span_constraints = parameters;
+    span_constraints.max_label = state.span;
+
+    allocate_solution(parameters, graph, state.current_solution, true);
+    random_solution(span_constraints, graph, state.current_solution, state.generator);
+    evaluate(parameters, graph, state.current_solution);
+
+    allocate_solution(parameters, graph, state.best_solution, false);
+    copy_solution(graph, state.current_solution, state.best_solution);
+
+    size_t table_size = (size_t) graph.vertex_count * state.width;
+
+    state.label_conflicts = new int[table_size];
+    state.tabu = new int[table_size];
+
+    fill(state.label_conflicts, state.label_conflicts + table_size, 0);
+    fill(state.tabu, state.tabu + table_size, 0);
+
+    /* every constraint vertex is violated by the labels closer to its own than the required separation */
+    label_type* labels = state.current_solution.labels;
+    int violations = 0;
+
+    for(int i = 0; i < graph.vertex_count; ++i)
+    {
+        int* row = state.label_conflicts + (size_t) i * state.width;
+
+        for(int j = graph.constraint_offsets[i]; j < graph.constraint_offsets[i + 1]; ++j)
+        {
+            int neighbor = graph.constraint_vertexes[j] & CONSTRAINT_VERTEX;
+            int required = state.separation[graph.constraint_vertexes[j] >> CONSTRAINT_DISTANCE_SHIFT];
+
+            /* a loop is violated with every label of the vertex, as evaluate() counts it, but no move fixes it */
+            if(neighbor == i)
+            {
+                if(required > 0)
+                {
+                    for(int label = 1; label < state.width; ++label)
+                    {
+                        ++row[label];
+                    }
+
+                    --violations;
+                }
+
+                continue;
+            }
+
+            /* no move changes the constraints between predefined vertexes, they are not counted */
+            if(graph.solution_backbone[i] && graph.solution_backbone[neighbor] && abs(labels[i] - labels[neighbor]) < required)
+            {
+                --violations;
+            }
+
+            for(int label = max(1, labels[neighbor] - required + 1); label <= min(state.width - 1, labels[neighbor] + required - 1); ++label)
+            {
+                ++row[label];
+            }
+        }
+
+        violations += row[labels[i]];
+    }
+
+    /* every violated constraint was counted at both of its vertexes */
+    state.violations = violations / 2;
+    state.best_violations = state.violations;
+}
+
+template<typename label_type>
+void tabu_search(parameters& parameters, graph& graph, state<label_type>& state)
+{
+    solution<label_type>& current = state.current_solution;
+
+    while(state.iteration < parameters.max_iterations && !time_is_up(parameters.time_limit))
+    {
+        /* the solution may still have no violated constraints with the smaller span */
+        if(state.violations == 0)
+        {
+            /* the best solution is the current one, it has no conflicting vertex */
+            if(parameters.stop_feasible && current.is_correct)
+            {
+                return;
+            }
+
+            if(!reduce_span(parameters, graph, state))
+            {
+                return;
+            }
+
+            if(parameters.run_stats.enabled)
+            {
+                ++state.span_reductions;
+            }
+
+            continue;
+        }
+
+        /* the constraints between predefined vertexes can not be fixed by a move */
+        if(current.conflicting_vertexes == 0)
+        {
+            return;
+        }
+
+        int vertex;
+        int label;
+
+        /* every move may be tabu, then a random one is done */
+        if(!select_move(state, vertex, label))
+        {
+            vertex = random_conflicting_vertex(current, state.generator);
+            label = random_int(state.generator, state.span) + 1;
+        }
+
+        /* the vertex may not go back to its label for the tabu tenure */
+        state.tabu[(size_t) vertex * state.width + current.labels[vertex]] = state.iteration +
+            random_int(state.generator, parameters.tabu_tenure + 1) + (int) (TENURE_FACTOR * current.conflicting_vertexes);
+
+        int previous_violations = state.violations;
+
+        apply_move(parameters, graph, state, vertex, label);
+
+        if(parameters.run_stats.enabled && state.violations < previous_violations)
+        {
+            ++state.improving_moves;
+        }
+
+        ++state.iteration;
+
+        state.best_violations = min(state.best_violations, state.violations);
+        update_best_solution(graph, state);
+
+        /* a progress record is only written if the best solution improved since the last one */
+        if(state.iteration % TIME_CHECK_INTERVAL == 0)
+        {
+            report_progress(parameters.progress_records, parameters.start_time, state.iteration, graph, state.best_solution);
+        }
+    }
+}
+
+template<typename label_type>
+bool select_move(state<label_type>& state, int& vertex, int& label)
+{
+    solution<label_type>& current = state.current_solution;
+
+    int best_change = INT_MAX;
+    int ties = 0;
+
+    for(int i = 0; i < current.conflicting_vertexes; ++i)
+    {
+        int candidate = current.conflict_set[i];
+        int current_label = current.labels[candidate];
+
+        const int* conflicts = state.label_conflicts + (size_t) candidate * state.width;
+        const int* tabu = state.tabu + (size_t) candidate * state.width;
+
+        for(int j = 1; j <= state.span; ++j)
+        {
+            int change = conflicts[j] - conflicts[current_label];
+
+            if(j == current_label || change > best_change)
+            {
+                continue;
+            }
+
+            /* a tabu move is only allowed if it leads to fewer violated constraints than found before */
+            if(tabu[j] > state.iteration && state.violations + change >= state.best_violations)
+            {
+                continue;
+            }
+
+            if(change < best_change)
+            {
+                best_change = change;
+                ties = 0;
+            }
+
+            /* pick one of the best moves uniformly at random */
+            if(random_int(state.generator, ++ties) == 0)
+            {
+                vertex = candidate;
+                label = j;
+            }
+        }
+    }
+
+    return ties > 0;
+}
+
+template<typename label_type>
+void apply_move(parameters& parameters, graph& graph, state<label_type>& state, int vertex, int label)
+{
+    int old_label = state.current_solution.labels[vertex];
+    const int* conflicts = state.label_conflicts + (size_t) vertex * state.width;
+
+    state.violations += conflicts[label] - conflicts[old_label];
+
+    /* the constraint vertexes are now violated around the new label instead of the old one */
+    for(int i = graph.constraint_offsets[vertex]; i < graph.constraint_offsets[vertex + 1]; ++i)
+    {
+        int neighbor = graph.constraint_vertexes[i] & CONSTRAINT_VERTEX;
+        int required = state.separation[graph.constraint_vertexes[i] >> CONSTRAINT_DISTANCE_SHIFT];
+
+        /* a loop is violated with every label, its entries do not change */
+        if(neighbor == vertex)
+        {
+            continue;
+        }
+
+        int* row = state.label_conflicts + (size_t) neighbor * state.width;
+
+        for(int j = max(1, old_label - required + 1); j <= min(state.width - 1, old_label + required - 1); ++j)
+        {
+            --row[j];
+        }
+
+        for(int j = max(1, label - required + 1); j <= min(state.width - 1, label + required - 1); ++j)
+        {
+            ++row[j];
+        }
+    }
+
+    relabel(parameters, graph, state.current_solution, vertex, label);
+}
+
+template<typename label_type>
+bool reduce_span(parameters& parameters, graph& graph, state<label_type>& state)
+{
+    /* the predefined labels have to stay */
+    int span = state.current_solution.chromatic_number - 1;
+
+    if(span < max(1, graph.max_fixed_label))
+    {
+        return false;
+    }
+
+    state.span = span;
+
+    for(int i = 0; i < graph.vertex_count - graph.fixed_vertex_count; ++i)
+    {
+        int vertex = graph.free_vertexes[i];
+
+        if(state.current_solution.labels[vertex] > span)
+        {
+            apply_move(parameters, graph, state, vertex, random_int(state.generator, span) + 1);
+        }
+    }
+
+    state.best_violations = state.violations;
+
+    return true;
+}
+
+template<typename label_type>
+void update_best_solution(graph& graph, state<label_type>& state)
+{
+    solution<label_type>& current = state.current_solution;
+    solution<label_type>& best = state.best_solution;
+
+    /* fewer conflicting vertexes are better than any smaller chromatic number */
+    int current_conflicts = current.conflicting_vertexes + current.conflicting_fixed;
+    int best_conflicts = best.conflicting_vertexes + best.conflicting_fixed;
+
+    if(current_conflicts != best_conflicts ? current_conflicts < best_conflicts : current.fitness > best.fitness)
+    {
+        copy_solution(graph, current, best);
+        state.best_iteration = state.iteration;
+    }
+}
+
+template<typename label_type>
+void print_state(ostream& output, parameters& parameters, graph& graph, state<label_type>& state)
+{
+    output << elapsed_time(parameters.start_time) << endl;
+    output << state.iteration << endl;
+    output << state.best_iteration << endl;
+
+    print_solution(output, graph, state.best_solution);
+}
+
+template<typename label_type>
+void release(state<label_type>& state)
+{
+    free_solution(state.current_solution);
+    free_solution(state.best_solution);
+
+    delete[] state.label_conflicts;
+    delete[] state.tabu;
+}
@@ -0,0 +1,48 @@
+/*  Borsos Barna
+
+    Reusable barrier for a fixed number of threads. The last thread to
+    arrive runs a serial step before the others are released, so the
+    step sees every thread stopped at the same point.
+*/
+
+#ifndef LABELING_BARRIER_H
+#define LABELING_BARRIER_H
+
+#include <mutex>
+#include <condition_variable>
+
+struct barrier
+{
+    std::mutex lock;                        // guards the counters below
+    std::condition_variable released;       // signaled when a phase is over
+    int thread_count;                       // number of threads meeting at the barrier
+    int waiting;                            // threads arrived in the current phase
+    int phase;                              // number of completed phases
+
+    explicit barrier(int thread_count) : thread_count(thread_count), waiting(0), phase(0) {}
+
+    template<typename step>
+    void arrive_and_wait(step serial_step)
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        int arrival_phase = phase;
+
+        if(++waiting == thread_count)
+        {
+            serial_step();
+
+            waiting = 0;
+            ++phase;
+            released.notify_all();
+        }
+        else
+        {
+            while(phase == arrival_phase)
+            {
+                released.wait(guard);
+            }
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,377 @@
+/*  Borsos Barna */
+
+#include "labeling/daemon.h"
+
+#include <iostream>
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <queue>
+#include <map>
+#include <algorithm>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+
+#include "labeling/graph_cache.h"
+#include "labeling/options.h"
+#include "labeling/timer.h"
+
+using namespace std;
+
+struct job
+{
+    string id;                          // id given by the client
+    bool cancel;                        // a cancel of the job with the id, not a job
+    bool invalid;                       // the header has no valid size, the job gets an error result and ends the input
+    vector<string> arguments;           // command line arguments, program name first
+    string content;                     // input file
+    shared_ptr<atomic<bool>> cancelled; // cancel flag of the job
+};
+
+struct cache_entry
+{
+    shared_ptr<graph> loaded;           // parsed graph, freed with its last user
+    long long last_used;                // time of the last use, in jobs
+};
+
+struct job_server
+{
+    job_function solve;                 // algorithm run for every job
+
+    mutex queue_lock;
+    condition_variable queue_changed;   // a job arrived or the input ended
+    queue<job> jobs;                    // jobs waiting for a worker
+    bool closed;                        // no more jobs will arrive
+
+    mutex cache_lock;
+    map<string, cache_entry> cache;     // parsed graphs by the key of their input file
+    long long cache_clock;              // number of graph lookups
+    const char* cache_path;             // directory of the preprocessed graphs (NULL: memory only)
+
+    mutex output_lock;                  // results are written one at a time
+
+    mutex cancel_lock;
+    map<string, shared_ptr<atomic<bool>>> cancel_flags; // cancel flags of the queued and running jobs by id
+};
+
+struct progress_buffer : stringbuf
+{
+    job_server& server;
+    string id;                          // job of the progress records
+
+    progress_buffer(job_server& server, const string& id) : server(server), id(id) {}
+
+    int sync();
+};
+
+static bool read_job(istream&, job&);
+static void work(job_server&);
+static shared_ptr<graph> cached_graph(job_server&, const string&);
+static void release_graph(graph*);
+static void write_result(job_server&, const string&, const string&, string);
+static void cancel_job(job_server&, const string&);
+
+int run_daemon(int argc, char** argv, job_function solve)
+{
+    job_server server;
+    server.solve = solve;
+    server.closed = false;
+    server.cache_clock = 0;
+    server.cache_path = get_option(argc, argv, 2, "cache");
+
+    int workers = get_option(argc, argv, 2, "workers", max(1, (int) thread::hardware_concurrency()));
+
+    cancel_on_signals();
+
+    vector<thread> threads;
+
+    for(int i = 0; i < max(1, workers); ++i)
+    {
+        threads.push_back(thread(work, ref(server)));
+    }
+
+    /* queue the jobs until the input ends */
+    job job;
+
+    while(read_job(cin, job))
+    {
+        if(job.cancel)
+        {
+            cancel_job(server, job.id);
+            continue;
+        }
+
+        /* the content of the job can not be told from the next job, nothing after it is read */
+        if(job.invalid)
+        {
+            write_result(server, job.id, "1", "Error: check parameters!");
+            break;
+        }
+
+        job.cancelled = make_shared<atomic<bool>>(false);
+
+        {
+            lock_guard<mutex> guard(server.cancel_lock);
+            server.cancel_flags[job.id] = job.cancelled;
+        }
+
+        lock_guard<mutex> guard(server.queue_lock);
+        server.jobs.push(job);
+        server.queue_changed.notify_one();
+    }
+
+    {
+        lock_guard<mutex> guard(server.queue_lock);
+        server.closed = true;
+        server.queue_changed.notify_all();
+    }
+
+    for(size_t i = 0; i < threads.size(); ++i)
+    {
+        threads[i].join();
+    }
+
+    return 0;
+}
+
+static bool read_job(istream& input, job& job)
+{
+    /* the header is read as a line, so a bad one is never taken for a part of the next job */
+    string header;
+
+    do
+    {
+        if(!getline(input, header))
+        {
+            return false;
+        }
+    }
+    while(header.find_first_not_of(" \t\r") == string::npos);
+
+    istringstream fields(header);
+    string size;
+
+    fields >> job.id >> size;
+
+    job.cancel = size == "cancel";
+    job.invalid = false;
+
+    if(job.cancel)
+    {
+        return true;
+    }
+
+    char* size_end;
+    errno = 0;
+    unsigned long bytes = strtoul(size.c_str(), &size_end, 10);
+
+    /* the arguments line of the job is read even without a valid size */
+    string line;
+    getline(input, line);
+
+    if(!isdigit((unsigned char) size[0]) || *size_end || errno == ERANGE || bytes > MAX_JOB_SIZE)
+    {
+        job.invalid = true;
+        return true;
+    }
+
+    /* split the arguments, the program name comes first like on the command line */
+    istringstream arguments(line);
+    string argument;
+
+    job.arguments.assign(1, "daemon");
+    while(arguments >> argument)
+    {
+        job.arguments.push_back(argument);
+    }
+
+    job.content.resize(bytes);
+    input.read(&job.content[0], bytes);
+
+    return (bool) input;
+}
+
+static void work(job_server& server)
+{
+    while(true)
+    {
+        job job;
+
+        {
+            unique_lock<mutex> guard(server.queue_lock);
+
+            while(server.jobs.empty() && !server.closed)
+            {
+                server.queue_changed.wait(guard);
+            }
+
+            if(server.jobs.empty())
+            {
+                return;
+            }
+
+            job = server.jobs.front();
+            server.jobs.pop();
+        }
+
+        vector<char*> argv;
+
+        for(size_t i = 0; i < job.arguments.size(); ++i)
+        {
+            argv.push_back(&job.arguments[i][0]);
+        }
+        argv.push_back(NULL);
+
+        ostringstream output;
+        progress_buffer progress_records(server, job.id);
+        ostream progress(&progress_records);
+        int status = 0;
+
+        /* the deadlines of the job stop with its cancel flag */
+        set_cancel_flag(job.cancelled.get());
+
+        try
+        {
+            shared_ptr<graph> graph = cached_graph(server, job.content);
+            server.solve(argv.size() - 1, argv.data(), *graph, output, progress);
+        }
+        catch(input_error& error)
+        {
+            output.str("");
+            output << "Error: invalid input file (line " << error.line << ")!" << endl;
+            status = 1;
+        }
+        catch(...)
+        {
+            output.str("");
+            output << "Error: check parameters!" << endl;
+            status = 1;
+        }
+
+        progress.flush();
+        write_result(server, job.id, to_string(status), output.str());
+
+        set_cancel_flag(NULL);
+
+        lock_guard<mutex> guard(server.cancel_lock);
+
+        /* a later job may have taken the id */
+        map<string, shared_ptr<atomic<bool>>>::iterator flag = server.cancel_flags.find(job.id);
+
+        if(flag != server.cancel_flags.end() && flag->second == job.cancelled)
+        {
+            server.cancel_flags.erase(flag);
+        }
+    }
+}
+
+static shared_ptr<graph> cached_graph(job_server& server, const string& content)
+{
+    string key = graph_key(content);
+
+    {
+        lock_guard<mutex> guard(server.cache_lock);
+        map<string, cache_entry>::iterator entry = server.cache.find(key);
+
+        if(entry != server.cache.end())
+        {
+            entry->second.last_used = ++server.cache_clock;
+            return entry->second.loaded;
+        }
+    }
+
+    /* load outside of the lock, other workers may use the cache meanwhile */
+    graph* parsed = new graph;
+
+    try
+    {
+        load_cached_graph(content, server.cache_path, *parsed);
+    }
+    catch(...)
+    {
+        delete parsed;
+        throw;
+    }
+
+    shared_ptr<graph> loaded(parsed, release_graph);
+
+    lock_guard<mutex> guard(server.cache_lock);
+
+    /* drop the least recently used graph, the jobs still using it keep it alive */
+    if(server.cache.size() >= GRAPH_CACHE_SIZE)
+    {
+        map<string, cache_entry>::iterator oldest = server.cache.begin();
+
+        for(map<string, cache_entry>::iterator i = server.cache.begin(); i != server.cache.end(); ++i)
+        {
+            if(i->second.last_used < oldest->second.last_used)
+            {
+                oldest = i;
+            }
+        }
+
+        server.cache.erase(oldest);
+    }
+
+    cache_entry& entry = server.cache[key];
+    entry.loaded = loaded;
+    entry.last_used = ++server.cache_clock;
+
+    return loaded;
+}
+
+static void release_graph(graph* graph)
+{
+    free_graph(*graph);
+    delete graph;
+}
+
+int progress_buffer::sync()
+{
+    /* the records written since the last flush */
+    if(!str().empty())
+    {
+        write_result(server, id, "progress", str());
+        str("");
+    }
+
+    return 0;
+}
+
+static void write_result(job_server& server, const string& id, const string& status, string output)
+{
+    /* the last line of the output may lack its line break */
+    if(!output.empty() && output[output.size() - 1] != '\n')
+    {
+        output += '\n';
+    }
+
+    int lines = 0;
+
+    for(size_t i = 0; i < output.size(); ++i)
+    {
+        lines += output[i] == '\n';
+    }
+
+    lock_guard<mutex> guard(server.output_lock);
+
+    cout << id << ' ' << status << ' ' << lines << '\n' << output;
+    cout.flush();
+}
+
+static void cancel_job(job_server& server, const string& id)
+{
+    lock_guard<mutex> guard(server.cancel_lock);
+    map<string, shared_ptr<atomic<bool>>>::iterator flag = server.cancel_flags.find(id);
+
+    if(flag != server.cancel_flags.end())
+    {
+        *flag->second = true;
+    }
+}
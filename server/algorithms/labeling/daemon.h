@@ -0,0 +1,54 @@
+/*  Borsos Barna
+
+    Daemon mode of the algorithms. Jobs arrive on the standard input and
+    are solved by a pool of worker threads, so a job pays neither the
+    start of a process nor the reading of a file. The parsed graphs are
+    kept between jobs by the key of their input file, the last
+    GRAPH_CACHE_SIZE of them, and also on disk with --cache (see
+    labeling/graph_cache.h).
+
+    JOB
+        line 1: job id, size of the input file (bytes)
+        line 2: command line arguments of the algorithm ("-" in place of the file path)
+        next size bytes: input file
+
+        A size that is not a number or is above MAX_JOB_SIZE gets a
+        result with exit status 1 for the job id. The end of such a job
+        is not known, so it ends the reading of the jobs: the jobs read
+        before it are finished and the daemon exits.
+
+    CANCEL
+        line 1: job id, "cancel"
+
+        The job stops as if its time was up, and its result is written
+        as usual. Unknown or finished jobs are ignored. SIGTERM and SIGINT
+        cancel every job and end the reading of the jobs.
+
+    RESULT
+        line 1: job id, exit status, line count
+        next line count lines: output of the algorithm
+
+    PROGRESS (jobs with --progress 1, see labeling/progress.h)
+        line 1: job id, "progress", line count
+        next line count lines: progress records
+
+    The results are written in the order the jobs finish, the progress
+    records of a job ahead of its result as soon as they are written.
+*/
+
+#ifndef LABELING_DAEMON_H
+#define LABELING_DAEMON_H
+
+#include <ostream>
+
+#include "labeling/graph.h"
+
+#define GRAPH_CACHE_SIZE 32
+#define MAX_JOB_SIZE (1UL << 30)    // greatest input file of a job (bytes)
+
+/* solves one job: command line arguments, graph, output, progress records */
+typedef void (*job_function)(int, char**, graph&, std::ostream&, std::ostream&);
+
+int run_daemon(int, char**, job_function);
+
+#endif
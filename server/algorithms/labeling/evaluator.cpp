@@ -0,0 +1,371 @@
+/*  Borsos Barna */
+
+#include "labeling/evaluator.h"
+
+#include <cstdlib>
+#include <algorithm>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define EVALUATOR_AVX2
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+using namespace std;
+
+template<typename label_type> static int count_conflicts(constraints&, graph&, solution<label_type>&, int, bool);
+template<typename label_type> static int count_conflicts_scalar(const int*, const int*, int, const label_type*, int, bool);
+#ifdef __SSE2__
+template<typename label_type> static int count_conflicts_sse2(const int*, const int*, int, const label_type*, int, bool);
+#endif
+#ifdef EVALUATOR_AVX2
+template<typename label_type> __attribute__((target("avx2"))) static int count_conflicts_avx2(const int*, const int*, int, const label_type*, int, bool);
+static bool supports_avx2();
+
+static const bool has_avx2 = supports_avx2();
+#endif
+template<typename label_type> static void update_conflicts(graph&, solution<label_type>&, int, int);
+
+template<typename label_type>
+void evaluate(constraints& constraints, graph& graph, solution<label_type>& solution)
+{
+    solution.conflicting_vertexes = 0;
+    solution.conflicting_fixed = 0;
+
+    for(int i = 0; i < graph.vertex_count; ++i)
+    {
+        bool is_conflicting;
+
+        /* a tracked solution needs every violated constraint, otherwise the first one is enough */
+        if(solution.conflicts)
+        {
+            solution.conflicts[i] = count_conflicts(constraints, graph, solution, i, false);
+            is_conflicting = solution.conflicts[i] > 0;
+        }
+        else
+        {
+            is_conflicting = is_conflicting_vertex(constraints, graph, solution, i);
+        }
+
+        if(solution.conflict_position)
+        {
+            solution.conflict_position[i] = -1;
+        }
+
+        if(is_conflicting)
+        {
+            if(graph.solution_backbone[i] == 0)
+            {
+                if(solution.conflict_set)
+                {
+                    solution.conflict_set[solution.conflicting_vertexes] = i;
+                    solution.conflict_position[i] = solution.conflicting_vertexes;
+                }
+
+                ++solution.conflicting_vertexes;
+            }
+            else
+            {
+                ++solution.conflicting_fixed;
+            }
+        }
+    }
+
+    /* calculate the chromatic number and the label histogram */
+    if(solution.label_count)
+    {
+        fill(solution.label_count, solution.label_count + label_count_size(constraints, graph), 0);
+    }
+
+    solution.chromatic_number = solution.labels[0];
+    for(int i = 0; i < graph.vertex_count; ++i)
+    {
+        if(solution.label_count)
+        {
+            ++solution.label_count[solution.labels[i]];
+        }
+
+        solution.chromatic_number = max(solution.chromatic_number, (int) solution.labels[i]);
+    }
+
+    solution.is_correct = solution.conflicting_vertexes == 0 && solution.conflicting_fixed == 0;
+    solution.fitness = fitness(constraints, graph, solution);
+}
+
+template<typename label_type>
+void relabel(constraints& constraints, graph& graph, solution<label_type>& solution, int vertex, int label)
+{
+    int old_label = solution.labels[vertex];
+
+    if(old_label == label)
+    {
+        return;
+    }
+
+    /* only the constraints between the vertex and its neighborhood can change */
+    int separation[4];
+    separations(constraints, separation);
+
+    int vertex_conflicts = solution.conflicts[vertex];
+
+    for(int i = graph.constraint_offsets[vertex]; i < graph.constraint_offsets[vertex + 1]; ++i)
+    {
+        int neighbor = graph.constraint_vertexes[i] & CONSTRAINT_VERTEX;
+        int required = separation[graph.constraint_vertexes[i] >> CONSTRAINT_DISTANCE_SHIFT];
+        int change = (abs(label - solution.labels[neighbor]) < required) -
+                     (abs(old_label - solution.labels[neighbor]) < required);
+
+        if(change && neighbor != vertex)
+        {
+            vertex_conflicts += change;
+            update_conflicts(graph, solution, neighbor, change);
+        }
+    }
+
+    update_conflicts(graph, solution, vertex, vertex_conflicts - solution.conflicts[vertex]);
+    solution.labels[vertex] = label;
+
+    /* update the label histogram and the chromatic number */
+    --solution.label_count[old_label];
+    ++solution.label_count[label];
+
+    if(label > solution.chromatic_number)
+    {
+        solution.chromatic_number = label;
+    }
+    else
+    {
+        while(solution.label_count[solution.chromatic_number] == 0)
+        {
+            --solution.chromatic_number;
+        }
+    }
+
+    solution.is_correct = solution.conflicting_vertexes == 0 && solution.conflicting_fixed == 0;
+    solution.fitness = fitness(constraints, graph, solution);
+}
+
+template<typename label_type>
+bool is_conflicting_vertex(constraints& constraints, graph& graph, solution<label_type>& solution, int vertex)
+{
+    return count_conflicts(constraints, graph, solution, vertex, true) > 0;
+}
+
+template<typename label_type>
+double fitness(constraints& constraints, graph& graph, solution<label_type>& solution)
+{
+    return (4 * (1 - (double)solution.conflicting_vertexes / graph.vertex_count) + (1 - (double)solution.chromatic_number / constraints.max_label)) / 5;
+}
+
+void separations(constraints& constraints, int* separation)
+{
+    /* required separation of a constraint vertex, indexed by its distance tags */
+    separation[0] = 0;
+    separation[CONSTRAINT_SECOND_NEIGHBOR >> CONSTRAINT_DISTANCE_SHIFT] = constraints.k;
+    separation[CONSTRAINT_NEIGHBOR >> CONSTRAINT_DISTANCE_SHIFT] = constraints.h;
+    separation[(CONSTRAINT_NEIGHBOR | CONSTRAINT_SECOND_NEIGHBOR) >> CONSTRAINT_DISTANCE_SHIFT] = max(constraints.h, constraints.k);
+}
+
+template<typename label_type>
+static int count_conflicts(constraints& constraints, graph& graph, solution<label_type>& solution, int vertex, bool first)
+{
+    /* violated constraints of the vertex, with first set only whether there is one */
+    int separation[4];
+    separations(constraints, separation);
+
+    const int* vertexes = graph.constraint_vertexes + graph.constraint_offsets[vertex];
+    int count = graph.constraint_offsets[vertex + 1] - graph.constraint_offsets[vertex];
+
+#ifdef EVALUATOR_AVX2
+    if(has_avx2)
+    {
+        return count_conflicts_avx2(separation, vertexes, count, solution.labels, solution.labels[vertex], first);
+    }
+#endif
+#ifdef __SSE2__
+    return count_conflicts_sse2(separation, vertexes, count, solution.labels, solution.labels[vertex], first);
+#else
+    return count_conflicts_scalar(separation, vertexes, count, solution.labels, solution.labels[vertex], first);
+#endif
+}
+
+template<typename label_type>
+static int count_conflicts_scalar(const int* separation, const int* vertexes, int count, const label_type* labels, int label, bool first)
+{
+    if(first)
+    {
+        for(int i = 0; i < count; ++i)
+        {
+            if(abs(label - labels[vertexes[i] & CONSTRAINT_VERTEX]) < separation[vertexes[i] >> CONSTRAINT_DISTANCE_SHIFT])
+            {
+                return 1;
+            }
+        }
+
+        return 0;
+    }
+
+    int conflicts = 0;
+
+    for(int i = 0; i < count; ++i)
+    {
+        conflicts += abs(label - labels[vertexes[i] & CONSTRAINT_VERTEX]) < separation[vertexes[i] >> CONSTRAINT_DISTANCE_SHIFT];
+    }
+
+    return conflicts;
+}
+
+#ifdef __SSE2__
+template<typename label_type>
+static int count_conflicts_sse2(const int* separation, const int* vertexes, int count, const label_type* labels, int label, bool first)
+{
+    /* 4 constraints at once, SSE2 has no gather so the labels are loaded one by one */
+    __m128i second_neighbor = _mm_set1_epi32(CONSTRAINT_SECOND_NEIGHBOR >> CONSTRAINT_DISTANCE_SHIFT);
+    __m128i neighbor = _mm_set1_epi32(CONSTRAINT_NEIGHBOR >> CONSTRAINT_DISTANCE_SHIFT);
+    __m128i second_separation = _mm_set1_epi32(separation[CONSTRAINT_SECOND_NEIGHBOR >> CONSTRAINT_DISTANCE_SHIFT]);
+    __m128i neighbor_separation = _mm_set1_epi32(separation[CONSTRAINT_NEIGHBOR >> CONSTRAINT_DISTANCE_SHIFT]);
+    __m128i both_separation = _mm_set1_epi32(separation[(CONSTRAINT_NEIGHBOR | CONSTRAINT_SECOND_NEIGHBOR) >> CONSTRAINT_DISTANCE_SHIFT]);
+    __m128i vertex_label = _mm_set1_epi32(label);
+    __m128i conflicts = _mm_setzero_si128();
+
+    int i = 0;
+    for(; i + 4 <= count; i += 4)
+    {
+        __m128i entries = _mm_loadu_si128((const __m128i*) (vertexes + i));
+        __m128i distance = _mm_srli_epi32(entries, CONSTRAINT_DISTANCE_SHIFT);
+        __m128i is_second = _mm_cmpeq_epi32(distance, second_neighbor);
+        __m128i is_neighbor = _mm_cmpeq_epi32(distance, neighbor);
+        __m128i is_both = _mm_andnot_si128(_mm_or_si128(is_second, is_neighbor), _mm_set1_epi32(-1));
+        __m128i required = _mm_or_si128(_mm_or_si128(_mm_and_si128(is_second, second_separation),
+                                                     _mm_and_si128(is_neighbor, neighbor_separation)),
+                                        _mm_and_si128(is_both, both_separation));
+
+        __m128i others = _mm_setr_epi32(labels[vertexes[i] & CONSTRAINT_VERTEX], labels[vertexes[i + 1] & CONSTRAINT_VERTEX],
+                                        labels[vertexes[i + 2] & CONSTRAINT_VERTEX], labels[vertexes[i + 3] & CONSTRAINT_VERTEX]);
+        __m128i difference = _mm_sub_epi32(others, vertex_label);
+        __m128i sign = _mm_srai_epi32(difference, 31);
+        difference = _mm_sub_epi32(_mm_xor_si128(difference, sign), sign);
+
+        __m128i conflicting = _mm_cmpgt_epi32(required, difference);
+
+        if(first)
+        {
+            if(_mm_movemask_epi8(conflicting))
+            {
+                return 1;
+            }
+        }
+        else
+        {
+            conflicts = _mm_sub_epi32(conflicts, conflicting);
+        }
+    }
+
+    int lanes[4];
+    _mm_storeu_si128((__m128i*) lanes, conflicts);
+
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] +
+           count_conflicts_scalar(separation, vertexes + i, count - i, labels, label, first);
+}
+#endif
+
+#ifdef EVALUATOR_AVX2
+template<typename label_type>
+__attribute__((target("avx2")))
+static int count_conflicts_avx2(const int* separation, const int* vertexes, int count, const label_type* labels, int label, bool first)
+{
+    /* 8 constraints at once, the separations are looked up by permuting a table with the distance tags */
+    __m256i table = _mm256_setr_epi32(separation[0], separation[1], separation[2], separation[3], 0, 0, 0, 0);
+    __m256i vertex_mask = _mm256_set1_epi32(CONSTRAINT_VERTEX);
+    __m256i label_mask = _mm256_set1_epi32((int) (label_type) -1);
+    __m256i vertex_label = _mm256_set1_epi32(label);
+    __m256i conflicts = _mm256_setzero_si256();
+
+    int i = 0;
+    for(; i + 8 <= count; i += 8)
+    {
+        __m256i entries = _mm256_loadu_si256((const __m256i*) (vertexes + i));
+        __m256i required = _mm256_permutevar8x32_epi32(table, _mm256_srli_epi32(entries, CONSTRAINT_DISTANCE_SHIFT));
+        __m256i others = _mm256_i32gather_epi32((const int*) labels, _mm256_and_si256(entries, vertex_mask), sizeof(label_type));
+
+        /* a narrow label is loaded with the labels after it (LABEL_PADDING covers the last one) */
+        if(sizeof(label_type) < sizeof(int))
+        {
+            others = _mm256_and_si256(others, label_mask);
+        }
+        __m256i difference = _mm256_abs_epi32(_mm256_sub_epi32(others, vertex_label));
+
+        __m256i conflicting = _mm256_cmpgt_epi32(required, difference);
+
+        if(first)
+        {
+            if(!_mm256_testz_si256(conflicting, conflicting))
+            {
+                return 1;
+            }
+        }
+        else
+        {
+            conflicts = _mm256_sub_epi32(conflicts, conflicting);
+        }
+    }
+
+    int lanes[8];
+    _mm256_storeu_si256((__m256i*) lanes, conflicts);
+
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + lanes[4] + lanes[5] + lanes[6] + lanes[7] +
+           count_conflicts_scalar(separation, vertexes + i, count - i, labels, label, first);
+}
+
+static bool supports_avx2()
+{
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+}
+#endif
+
+template<typename label_type>
+static void update_conflicts(graph& graph, solution<label_type>& solution, int vertex, int change)
+{
+    bool was_conflicting = solution.conflicts[vertex] > 0;
+    solution.conflicts[vertex] += change;
+    bool is_conflicting = solution.conflicts[vertex] > 0;
+
+    if(was_conflicting != is_conflicting)
+    {
+        if(graph.solution_backbone[vertex] == 0)
+        {
+            if(is_conflicting)
+            {
+                /* append to the conflict set */
+                solution.conflict_set[solution.conflicting_vertexes] = vertex;
+                solution.conflict_position[vertex] = solution.conflicting_vertexes;
+                ++solution.conflicting_vertexes;
+            }
+            else
+            {
+                /* move the last vertex of the conflict set into the place of the removed one */
+                int last = solution.conflict_set[--solution.conflicting_vertexes];
+                solution.conflict_set[solution.conflict_position[vertex]] = last;
+                solution.conflict_position[last] = solution.conflict_position[vertex];
+                solution.conflict_position[vertex] = -1;
+            }
+        }
+        else
+        {
+            solution.conflicting_fixed += is_conflicting ? 1 : -1;
+        }
+    }
+}
+
+#define INSTANTIATE_EVALUATOR(label_type) \
+    template void evaluate(constraints&, graph&, solution<label_type>&); \
+    template void relabel(constraints&, graph&, solution<label_type>&, int, int); \
+    template bool is_conflicting_vertex(constraints&, graph&, solution<label_type>&, int); \
+    template double fitness(constraints&, graph&, solution<label_type>&);
+
+/* the label types of the algorithms */
+INSTANTIATE_EVALUATOR(uint8_t)
+INSTANTIATE_EVALUATOR(uint16_t)
+INSTANTIATE_EVALUATOR(int)
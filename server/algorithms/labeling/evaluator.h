@@ -0,0 +1,20 @@
+/*  Borsos Barna
+
+    Evaluation of L(h, k) labelings.
+
+    fitness = (4 * (1 - conflicting vertexes / vertex count) + (1 - chromatic number / max. label)) / 5
+*/
+
+#ifndef LABELING_EVALUATOR_H
+#define LABELING_EVALUATOR_H
+
+#include "labeling/graph.h"
+#include "labeling/solution.h"
+
+void separations(constraints&, int*);
+template<typename label_type> void evaluate(constraints&, graph&, solution<label_type>&);
+template<typename label_type> void relabel(constraints&, graph&, solution<label_type>&, int, int);
+template<typename label_type> bool is_conflicting_vertex(constraints&, graph&, solution<label_type>&, int);
+template<typename label_type> double fitness(constraints&, graph&, solution<label_type>&);
+
+#endif
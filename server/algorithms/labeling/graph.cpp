@@ -0,0 +1,470 @@
+/*  Borsos Barna
+
+    INPUT FILE
+        line 1: vertex count, edge count, predefined vertex count
+        next edge count lines: edge endpoints (1-based)
+        next predefined vertex count lines: vertex (1-based), label
+
+    The numbers of a line are separated by blanks, the lines after the
+    predefined vertexes are ignored. A malformed line throws input_error
+    with its line number, like the checks of the controllers did.
+*/
+
+#include "labeling/graph.h"
+#include "labeling/graph_file.h"
+
+#include <climits>
+#include <fstream>
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+#include <atomic>
+#include <thread>
+
+using namespace std;
+
+#define READ_BUFFER_SIZE (1 << 20)
+#define CONSTRAINT_BLOCK 1024           // vertexes handed to a thread at once
+
+struct line_reader
+{
+    istream* input;                 // text being read
+    char* buffer;                   // current block of the text
+    int position;                   // next character in the buffer
+    int size;                       // characters in the buffer
+};
+
+static void collect_constraint_vertexes(graph&, atomic<int>&, bool);
+static int peek(line_reader&);
+static bool read_line(line_reader&, int*, int);
+
+void load_graph(const char* file_path, graph& graph)
+{
+    /* read data from file */
+    ifstream file(file_path, ios_base::in | ios_base::binary);
+
+    if(!file)
+    {
+        throw invalid_argument(file_path);
+    }
+
+    read_graph(file, graph);
+
+    /* close file */
+    file.close();
+}
+
+void read_graph(istream& file, graph& graph)
+{
+    graph.mapping = NULL;
+    graph.mapping_size = 0;
+
+    line_reader reader;
+    reader.input = &file;
+    reader.buffer = new char[READ_BUFFER_SIZE];
+    reader.position = reader.size = 0;
+
+    int* edges = NULL;
+    graph.solution_backbone = NULL;
+
+    try
+    {
+        int counts[3];
+
+        if(!read_line(reader, counts, 3) || counts[0] < 1 || counts[0] > CONSTRAINT_VERTEX || counts[1] < 0 || counts[2] < 0)
+        {
+            throw input_error(1);
+        }
+
+        graph.vertex_count = counts[0];
+        graph.edge_count = counts[1];
+
+        /* read edge list */
+        edges = new int[2 * graph.edge_count];
+        for(int i = 0; i < graph.edge_count; ++i)
+        {
+            if(!read_line(reader, edges + 2 * i, 2) ||
+               edges[2 * i] < 1 || edges[2 * i] > graph.vertex_count ||
+               edges[2 * i + 1] < 1 || edges[2 * i + 1] > graph.vertex_count)
+            {
+                throw input_error(i + 2);
+            }
+
+            --edges[2 * i]; --edges[2 * i + 1];
+        }
+
+        /* create solution backbone, a vertex given twice keeps its last label */
+        graph.solution_backbone = new int[graph.vertex_count]();
+        graph.fixed_vertex_count = 0;
+        graph.max_fixed_label = 0;
+        graph.max_fixed_label_line = 0;
+
+        int fixed[2];
+        for(int i = 0; i < counts[2]; ++i)
+        {
+            int line = graph.edge_count + i + 2;
+
+            if(!read_line(reader, fixed, 2) || fixed[0] < 1 || fixed[0] > graph.vertex_count || fixed[1] < 1)
+            {
+                throw input_error(line);
+            }
+
+            if(graph.solution_backbone[fixed[0] - 1] == 0)
+            {
+                ++graph.fixed_vertex_count;
+            }
+            graph.solution_backbone[fixed[0] - 1] = fixed[1];
+
+            if(fixed[1] > graph.max_fixed_label)
+            {
+                graph.max_fixed_label = fixed[1];
+                graph.max_fixed_label_line = line;
+            }
+        }
+    }
+    catch(...)
+    {
+        delete[] reader.buffer;
+        delete[] edges;
+        delete[] graph.solution_backbone;
+        throw;
+    }
+
+    delete[] reader.buffer;
+
+    neighbors(graph, edges);
+    constraint_vertexes(graph);
+    free_vertexes(graph);
+
+    delete[] edges;
+}
+
+void free_graph(graph& graph)
+{
+    if(graph.mapping)
+    {
+        unmap_graph_file(graph);
+        return;
+    }
+
+    delete[] graph.neighbor_offsets;
+    delete[] graph.neighbors;
+    delete[] graph.constraint_offsets;
+    delete[] graph.constraint_vertexes;
+    delete[] graph.solution_backbone;
+    delete[] graph.free_vertexes;
+}
+
+void neighbors(graph& graph, int* edges)
+{
+    /* count the adjacent vertexes of every vertex */
+    graph.neighbor_offsets = new int[graph.vertex_count + 1]();
+
+    for(int i = 0; i < graph.edge_count; ++i)
+    {
+        ++graph.neighbor_offsets[edges[2 * i] + 1];
+
+        if(edges[2 * i] != edges[2 * i + 1])
+        {
+            ++graph.neighbor_offsets[edges[2 * i + 1] + 1];
+        }
+    }
+
+    for(int i = 0; i < graph.vertex_count; ++i)
+    {
+        graph.neighbor_offsets[i + 1] += graph.neighbor_offsets[i];
+    }
+
+    /* fill neighbors, every edge is stored at both of its ends */
+    graph.neighbors = new int[graph.neighbor_offsets[graph.vertex_count]];
+    int* list_end = new int[graph.vertex_count];
+    copy(graph.neighbor_offsets, graph.neighbor_offsets + graph.vertex_count, list_end);
+
+    for(int i = 0; i < graph.edge_count; ++i)
+    {
+        graph.neighbors[list_end[edges[2 * i]]++] = edges[2 * i + 1];
+
+        if(edges[2 * i] != edges[2 * i + 1])
+        {
+            graph.neighbors[list_end[edges[2 * i + 1]]++] = edges[2 * i];
+        }
+    }
+
+    /* drop repeated edges */
+    int* last_seen = new int[graph.vertex_count];
+    fill(last_seen, last_seen + graph.vertex_count, -1);
+
+    int size = 0;
+    for(int i = 0; i < graph.vertex_count; ++i)
+    {
+        int list_begin = graph.neighbor_offsets[i];
+        graph.neighbor_offsets[i] = size;
+
+        for(int j = list_begin; j < list_end[i]; ++j)
+        {
+            if(last_seen[graph.neighbors[j]] != i)
+            {
+                last_seen[graph.neighbors[j]] = i;
+                graph.neighbors[size++] = graph.neighbors[j];
+            }
+        }
+    }
+    graph.neighbor_offsets[graph.vertex_count] = size;
+
+    delete[] list_end;
+    delete[] last_seen;
+}
+
+void constraint_vertexes(graph& graph)
+{
+    /* split the vertexes among the threads, blocks are handed out as the threads finish */
+    int thread_count = min(max(1, (int) thread::hardware_concurrency()),
+                           (graph.vertex_count + CONSTRAINT_BLOCK - 1) / CONSTRAINT_BLOCK);
+
+    graph.constraint_offsets = new int[graph.vertex_count + 1];
+    graph.constraint_offsets[0] = 0;
+
+    /* count the constrained vertexes of every vertex, then fill the lists at their exact places */
+    for(int pass = 0; pass < 2; ++pass)
+    {
+        atomic<int> next_block(0);
+        vector<thread> threads;
+
+        for(int i = 1; i < thread_count; ++i)
+        {
+            threads.push_back(thread(collect_constraint_vertexes, ref(graph), ref(next_block), pass == 1));
+        }
+        collect_constraint_vertexes(graph, next_block, pass == 1);
+
+        for(size_t i = 0; i < threads.size(); ++i)
+        {
+            threads[i].join();
+        }
+
+        if(pass == 0)
+        {
+            for(int i = 0; i < graph.vertex_count; ++i)
+            {
+                graph.constraint_offsets[i + 1] += graph.constraint_offsets[i];
+            }
+
+            graph.constraint_vertexes = new int[graph.constraint_offsets[graph.vertex_count]];
+        }
+    }
+}
+
+static void collect_constraint_vertexes(graph& graph, atomic<int>& next_block, bool fill)
+{
+    /* the last vertex which reached every vertex and the place of its entry, no list is sorted */
+    vector<int> last_seen(graph.vertex_count, -1);
+    vector<int> entry(fill ? graph.vertex_count : 0);
+
+    for(int block = next_block++; block * CONSTRAINT_BLOCK < graph.vertex_count; block = next_block++)
+    {
+        int last = min(graph.vertex_count, (block + 1) * CONSTRAINT_BLOCK);
+
+        for(int i = block * CONSTRAINT_BLOCK; i < last; ++i)
+        {
+            int size = fill ? graph.constraint_offsets[i] : 0;
+
+            /* the neighbors come first */
+            for(int j = graph.neighbor_offsets[i]; j < graph.neighbor_offsets[i + 1]; ++j)
+            {
+                int neighbor = graph.neighbors[j];
+                last_seen[neighbor] = i;
+
+                if(fill)
+                {
+                    entry[neighbor] = size;
+                    graph.constraint_vertexes[size] = neighbor | CONSTRAINT_NEIGHBOR;
+                }
+                ++size;
+            }
+
+            /* the neighbors of every neighbor, except the vertex itself, a neighbor is marked with both distances */
+            for(int j = graph.neighbor_offsets[i]; j < graph.neighbor_offsets[i + 1]; ++j)
+            {
+                int neighbor = graph.neighbors[j];
+
+                for(int k = graph.neighbor_offsets[neighbor]; k < graph.neighbor_offsets[neighbor + 1]; ++k)
+                {
+                    int candidate = graph.neighbors[k];
+
+                    if(candidate == i)
+                    {
+                        continue;
+                    }
+
+                    if(last_seen[candidate] != i)
+                    {
+                        last_seen[candidate] = i;
+
+                        if(fill)
+                        {
+                            entry[candidate] = size;
+                            graph.constraint_vertexes[size] = candidate | CONSTRAINT_SECOND_NEIGHBOR;
+                        }
+                        ++size;
+                    }
+                    else if(fill)
+                    {
+                        graph.constraint_vertexes[entry[candidate]] |= CONSTRAINT_SECOND_NEIGHBOR;
+                    }
+                }
+            }
+
+            if(!fill)
+            {
+                graph.constraint_offsets[i + 1] = size;
+            }
+        }
+    }
+}
+
+void free_vertexes(graph& graph)
+{
+    /* list the vertexes the algorithms may relabel */
+    graph.free_vertexes = new int[graph.vertex_count - graph.fixed_vertex_count];
+
+    for(int i = 0, j = 0; i < graph.vertex_count; ++i)
+    {
+        if(graph.solution_backbone[i] == 0)
+        {
+            graph.free_vertexes[j++] = i;
+        }
+    }
+}
+
+static int peek(line_reader& reader)
+{
+    /* read the text in large blocks instead of token by token */
+    if(reader.position == reader.size)
+    {
+        reader.input->read(reader.buffer, READ_BUFFER_SIZE);
+        reader.size = reader.input->gcount();
+        reader.position = 0;
+
+        if(reader.size == 0)
+        {
+            return -1;
+        }
+    }
+
+    return (unsigned char) reader.buffer[reader.position];
+}
+
+static bool read_line(line_reader& reader, int* values, int count)
+{
+    /* exactly count integers separated by blanks, then the end of the line */
+    int read = 0;
+    int character = peek(reader);
+
+    while(true)
+    {
+        while(character == ' ' || character == '\t' || character == '\r')
+        {
+            ++reader.position;
+            character = peek(reader);
+        }
+
+        if(character == '\n' || character == -1)
+        {
+            break;
+        }
+
+        if(read == count)
+        {
+            return false;
+        }
+
+        bool negative = character == '-';
+        if(negative)
+        {
+            ++reader.position;
+            character = peek(reader);
+        }
+
+        if(character < '0' || character > '9')
+        {
+            return false;
+        }
+
+        long long value = 0;
+        while(character >= '0' && character <= '9')
+        {
+            value = value * 10 + (character - '0');
+            if(value > INT_MAX)
+            {
+                return false;
+            }
+
+            ++reader.position;
+            character = peek(reader);
+        }
+
+        /* a number ends at a blank or at the end of the line */
+        if(character != ' ' && character != '\t' && character != '\r' && character != '\n' && character != -1)
+        {
+            return false;
+        }
+
+        values[read++] = negative ? -value : value;
+    }
+
+    if(character == '\n')
+    {
+        ++reader.position;
+    }
+
+    return read == count;
+}
+
+void bandwidth_order(graph& graph, int* order)
+{
+    /* Cuthill-McKee: breadth first search from a vertex of min. degree in every component,
+       the new neighbors of a vertex are taken by increasing degree */
+    vector<int> degree(graph.vertex_count);
+    vector<int> roots(graph.vertex_count);
+    vector<bool> visited(graph.vertex_count, false);
+
+    for(int i = 0; i < graph.vertex_count; ++i)
+    {
+        degree[i] = graph.neighbor_offsets[i + 1] - graph.neighbor_offsets[i];
+        roots[i] = i;
+    }
+
+    auto by_degree = [&](int a, int b)
+    {
+        return degree[a] < degree[b];
+    };
+
+    stable_sort(roots.begin(), roots.end(), by_degree);
+
+    int size = 0;
+    for(int i = 0; i < graph.vertex_count; ++i)
+    {
+        if(visited[roots[i]])
+        {
+            continue;
+        }
+
+        visited[roots[i]] = true;
+        order[size++] = roots[i];
+
+        for(int head = size - 1; head < size; ++head)
+        {
+            int first = size;
+
+            for(int j = graph.neighbor_offsets[order[head]]; j < graph.neighbor_offsets[order[head] + 1]; ++j)
+            {
+                if(!visited[graph.neighbors[j]])
+                {
+                    visited[graph.neighbors[j]] = true;
+                    order[size++] = graph.neighbors[j];
+                }
+            }
+
+            stable_sort(order + first, order + size, by_degree);
+        }
+    }
+}
@@ -0,0 +1,60 @@
+/*  Borsos Barna
+
+    Graph shared by the labeling algorithms.
+
+    Adjacency is stored in compressed sparse row form: the neighbors of
+    vertex v are neighbors[neighbor_offsets[v]] ... neighbors[neighbor_offsets[v + 1] - 1].
+
+    The labels of a vertex are constrained against its neighbors and the
+    vertexes at distance of 2 edges. Both are packed into one list of
+    constraint vertexes per vertex (in the same form), every entry being
+    a vertex tagged with the distances it is reached at. A vertex at both
+    distances is listed once and needs the greater separation.
+*/
+
+#ifndef LABELING_GRAPH_H
+#define LABELING_GRAPH_H
+
+#include <cstddef>
+#include <istream>
+
+#define CONSTRAINT_NEIGHBOR (1 << 30)           // the constraint vertex is adjacent
+#define CONSTRAINT_SECOND_NEIGHBOR (1 << 29)    // the constraint vertex is at distance of 2 edges
+#define CONSTRAINT_DISTANCE_SHIFT 29            // shift of the distance tags of a constraint vertex
+#define CONSTRAINT_VERTEX ((1 << 29) - 1)       // mask of the vertex of a constraint vertex
+
+struct graph
+{
+    int vertex_count;               // number of vertexes
+    int edge_count;                 // number of edges
+    int fixed_vertex_count;         // number of predefined vertexes
+    int max_fixed_label;            // greatest label of the predefined vertexes
+    int max_fixed_label_line;       // line of the input file with the greatest predefined label
+
+    int* neighbor_offsets;          // start of the adjacent vertexes of every vertex (CSR)
+    int* neighbors;                 // adjacent vertexes of all vertexes
+    int* constraint_offsets;        // start of the constraint vertexes of every vertex (CSR)
+    int* constraint_vertexes;       // constrained vertexes of all vertexes, tagged with their distances
+    int* solution_backbone;         // fixed vertexes of the solution (0 if not fixed)
+    int* free_vertexes;             // vertexes that are not predefined
+
+    void* mapping;                  // mapped graph file holding the arrays (NULL: arrays allocated)
+    size_t mapping_size;            // size of the mapped graph file
+};
+
+struct input_error
+{
+    int line;                       // line of the input file which is not valid
+
+    explicit input_error(int line) : line(line) {}
+};
+
+void load_graph(const char*, graph&);
+void read_graph(std::istream&, graph&);
+void free_graph(graph&);
+void neighbors(graph&, int*);
+void constraint_vertexes(graph&);
+void free_vertexes(graph&);
+void bandwidth_order(graph&, int*);
+
+#endif
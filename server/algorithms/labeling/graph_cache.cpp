@@ -0,0 +1,169 @@
+/*  Borsos Barna */
+
+#include "labeling/graph_cache.h"
+
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#include "labeling/graph_file.h"
+#include "labeling/sha256.h"
+
+using namespace std;
+
+#define KEY_BUFFER_SIZE (1 << 16)    // block of the file hashed at once
+
+/* the text in its canonical form: the numbers of a line separated by one space, lines by '\n' */
+struct text_hash
+{
+    sha256 hash;                    // hash of the canonical text so far
+    bool blank;                     // whitespace since the last character
+    bool line_start;                // no number on the current line yet
+};
+
+static void start_text_hash(text_hash& text)
+{
+    sha256_start(text.hash);
+    text.blank = false;
+    text.line_start = true;
+}
+
+static void hash_text(text_hash& text, const char* data, size_t size)
+{
+    /* the line structure is part of the input, only the spacing within and at the ends of lines is dropped */
+    char canonical[4096];
+    size_t length = 0;
+
+    for(size_t i = 0; i < size; ++i)
+    {
+        char character = data[i];
+
+        if(character == ' ' || character == '\t' || character == '\r')
+        {
+            text.blank = true;
+            continue;
+        }
+
+        if(length + 2 > sizeof(canonical))
+        {
+            sha256_update(text.hash, canonical, length);
+            length = 0;
+        }
+
+        if(character == '\n')
+        {
+            text.line_start = true;
+        }
+        else
+        {
+            if(text.blank && !text.line_start)
+            {
+                canonical[length++] = ' ';
+            }
+
+            text.line_start = false;
+        }
+
+        canonical[length++] = character;
+        text.blank = false;
+    }
+
+    sha256_update(text.hash, canonical, length);
+}
+
+string graph_key(const string& text)
+{
+    text_hash hash;
+    start_text_hash(hash);
+    hash_text(hash, text.data(), text.size());
+
+    return sha256_hex(hash.hash);
+}
+
+string graph_key(istream& file)
+{
+    /* the file is hashed block by block, it is never held in memory */
+    text_hash hash;
+    start_text_hash(hash);
+
+    char* buffer = new char[KEY_BUFFER_SIZE];
+
+    while(file.read(buffer, KEY_BUFFER_SIZE) || file.gcount() > 0)
+    {
+        hash_text(hash, buffer, file.gcount());
+    }
+
+    delete[] buffer;
+
+    return sha256_hex(hash.hash);
+}
+
+static string cache_file(const char* cache_directory, const string& key)
+{
+    return string(cache_directory) + "/" + key + ".graph";
+}
+
+static void read_cached_graph(istream& file, const string& path, graph& graph)
+{
+    read_graph(file, graph);
+
+    /* the cache is only an optimization, a failed write is not an error */
+    if(!path.empty())
+    {
+        write_graph_file(path.c_str(), graph);
+    }
+}
+
+void load_cached_graph(const string& text, const char* cache_directory, graph& graph)
+{
+    string path;
+
+    if(cache_directory)
+    {
+        path = cache_file(cache_directory, graph_key(text));
+
+        if(map_graph_file(path.c_str(), graph))
+        {
+            return;
+        }
+    }
+
+    istringstream file(text);
+    read_cached_graph(file, path, graph);
+}
+
+void load_graph_file(const char* file_path, const char* cache_directory, graph& graph)
+{
+    /* binary graph files are used in place */
+    if(map_graph_file(file_path, graph))
+    {
+        return;
+    }
+
+    /* text files are parsed straight from the file */
+    if(!cache_directory)
+    {
+        load_graph(file_path, graph);
+        return;
+    }
+
+    ifstream file(file_path, ios_base::in | ios_base::binary);
+
+    if(!file)
+    {
+        throw invalid_argument(file_path);
+    }
+
+    /* the key takes a pass over the file, it is parsed in a second pass on a miss */
+    string path = cache_file(cache_directory, graph_key(file));
+
+    if(map_graph_file(path.c_str(), graph))
+    {
+        return;
+    }
+
+    file.clear();
+    file.seekg(0);
+
+    read_cached_graph(file, path, graph);
+}
@@ -0,0 +1,27 @@
+/*  Borsos Barna
+
+    Cache of preprocessed graphs, addressed by the content of the input
+    file. The key is the SHA-256 hash of the lines of numbers of the file:
+    spacing and line endings do not matter, line breaks do, as they do for
+    the parser. A cache directory holds a binary graph file <key>.graph
+    for every graph (see labeling/graph_file.h).
+
+    Input files are not read into memory: without a cache they are parsed
+    straight from the file, with one their key is computed from blocks of
+    the file first.
+*/
+
+#ifndef LABELING_GRAPH_CACHE_H
+#define LABELING_GRAPH_CACHE_H
+
+#include <istream>
+#include <string>
+
+#include "labeling/graph.h"
+
+std::string graph_key(const std::string&);
+std::string graph_key(std::istream&);
+void load_cached_graph(const std::string&, const char*, graph&);
+void load_graph_file(const char*, const char*, graph&);
+
+#endif
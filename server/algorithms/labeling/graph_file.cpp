@@ -0,0 +1,236 @@
+/*  Borsos Barna */
+
+#include "labeling/graph_file.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "labeling/random.h"
+
+using namespace std;
+
+struct graph_file_header
+{
+    uint64_t magic;                 // GRAPH_FILE_MAGIC
+    int32_t version;                // GRAPH_FILE_VERSION
+    int32_t vertex_count;
+    int32_t edge_count;
+    int32_t fixed_vertex_count;
+    int32_t max_fixed_label;
+    int32_t max_fixed_label_line;
+    int32_t neighbors_count;        // length of the neighbors array
+    int32_t constraints_count;      // length of the constraint vertexes array
+};
+
+#define GRAPH_FILE_HEADER_SIZE 40   // size of the header in the file
+
+static bool valid_offsets(const int*, int, int, int64_t);
+static bool valid_arrays(graph&, graph_file_header&);
+
+bool map_graph_file(const char* file_path, graph& graph)
+{
+    int file = open(file_path, O_RDONLY);
+
+    if(file < 0)
+    {
+        return false;
+    }
+
+    struct stat status;
+    void* mapping = MAP_FAILED;
+
+    if(fstat(file, &status) == 0 && status.st_size >= GRAPH_FILE_HEADER_SIZE)
+    {
+        mapping = mmap(NULL, status.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+    }
+
+    /* the mapping stays valid after the file is closed */
+    close(file);
+
+    if(mapping == MAP_FAILED)
+    {
+        return false;
+    }
+
+    graph_file_header header;
+    memcpy(&header, mapping, GRAPH_FILE_HEADER_SIZE);
+
+    /* anything else, e.g. a text input file or a truncated file, is not a graph file */
+    int64_t arrays_size = 2 * ((int64_t) header.vertex_count + 1) + header.neighbors_count + header.constraints_count +
+                          2 * (int64_t) header.vertex_count - header.fixed_vertex_count;
+
+    if(header.magic != GRAPH_FILE_MAGIC || header.version != GRAPH_FILE_VERSION ||
+       header.vertex_count < 1 || header.vertex_count > CONSTRAINT_VERTEX ||
+       header.fixed_vertex_count < 0 || header.fixed_vertex_count > header.vertex_count ||
+       header.neighbors_count < 0 || header.constraints_count < 0 ||
+       status.st_size != GRAPH_FILE_HEADER_SIZE + arrays_size * (int64_t) sizeof(int32_t))
+    {
+        munmap(mapping, status.st_size);
+        return false;
+    }
+
+    graph.vertex_count = header.vertex_count;
+    graph.edge_count = header.edge_count;
+    graph.fixed_vertex_count = header.fixed_vertex_count;
+    graph.max_fixed_label = header.max_fixed_label;
+    graph.max_fixed_label_line = header.max_fixed_label_line;
+
+    int* arrays = (int*) ((char*) mapping + GRAPH_FILE_HEADER_SIZE);
+
+    graph.neighbor_offsets = arrays;
+    graph.neighbors = graph.neighbor_offsets + graph.vertex_count + 1;
+    graph.constraint_offsets = graph.neighbors + header.neighbors_count;
+    graph.constraint_vertexes = graph.constraint_offsets + graph.vertex_count + 1;
+    graph.solution_backbone = graph.constraint_vertexes + header.constraints_count;
+    graph.free_vertexes = graph.solution_backbone + graph.vertex_count;
+
+    /* a damaged file is not used, the graph is built from its text again */
+    if(!valid_arrays(graph, header))
+    {
+        munmap(mapping, status.st_size);
+        return false;
+    }
+
+    graph.mapping = mapping;
+    graph.mapping_size = status.st_size;
+
+    return true;
+}
+
+static bool valid_offsets(const int* offsets, int vertex_count, int count, int64_t max_count)
+{
+    /* the lists of the vertexes follow each other and fill the array */
+    if(offsets[0] != 0 || offsets[vertex_count] != count || count > max_count)
+    {
+        return false;
+    }
+
+    for(int i = 0; i < vertex_count; ++i)
+    {
+        if(offsets[i] > offsets[i + 1])
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool valid_arrays(graph& graph, graph_file_header& header)
+{
+    /* the algorithms index with every value of the arrays, so all of them are checked once here */
+    int vertex_count = graph.vertex_count;
+
+    if(graph.edge_count < 0 ||
+       !valid_offsets(graph.neighbor_offsets, vertex_count, header.neighbors_count, 2 * (int64_t) graph.edge_count) ||
+       !valid_offsets(graph.constraint_offsets, vertex_count, header.constraints_count, INT32_MAX))
+    {
+        return false;
+    }
+
+    for(int i = 0; i < header.neighbors_count; ++i)
+    {
+        if(graph.neighbors[i] < 0 || graph.neighbors[i] >= vertex_count)
+        {
+            return false;
+        }
+    }
+
+    /* a constraint vertex has one or both distance tags and no other bits */
+    for(int i = 0; i < header.constraints_count; ++i)
+    {
+        int constraint = graph.constraint_vertexes[i];
+
+        if(constraint < 0 || (constraint >> CONSTRAINT_DISTANCE_SHIFT) == 0 || (constraint & CONSTRAINT_VERTEX) >= vertex_count)
+        {
+            return false;
+        }
+    }
+
+    /* the predefined labels are checked against max. label by every run, see check_fixed_labels() */
+    int fixed_vertex_count = 0;
+    int max_fixed_label = 0;
+
+    for(int i = 0; i < vertex_count; ++i)
+    {
+        if(graph.solution_backbone[i] < 0)
+        {
+            return false;
+        }
+
+        fixed_vertex_count += graph.solution_backbone[i] != 0;
+        max_fixed_label = max(max_fixed_label, graph.solution_backbone[i]);
+    }
+
+    if(fixed_vertex_count != graph.fixed_vertex_count || max_fixed_label != graph.max_fixed_label)
+    {
+        return false;
+    }
+
+    /* the free vertexes are the vertexes without a label, in increasing order */
+    for(int i = 0; i < vertex_count - graph.fixed_vertex_count; ++i)
+    {
+        int vertex = graph.free_vertexes[i];
+
+        if(vertex < 0 || vertex >= vertex_count || graph.solution_backbone[vertex] != 0 ||
+           (i > 0 && vertex <= graph.free_vertexes[i - 1]))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void unmap_graph_file(graph& graph)
+{
+    munmap(graph.mapping, graph.mapping_size);
+    graph.mapping = NULL;
+}
+
+bool write_graph_file(const char* file_path, graph& graph)
+{
+    /* write under a temporary name, readers only ever see complete files */
+    ostringstream temporary_path;
+    temporary_path << file_path << '.' << random_seed() << ".tmp";
+
+    ofstream file(temporary_path.str().c_str(), ios_base::out | ios_base::binary);
+
+    graph_file_header header;
+    header.magic = GRAPH_FILE_MAGIC;
+    header.version = GRAPH_FILE_VERSION;
+    header.vertex_count = graph.vertex_count;
+    header.edge_count = graph.edge_count;
+    header.fixed_vertex_count = graph.fixed_vertex_count;
+    header.max_fixed_label = graph.max_fixed_label;
+    header.max_fixed_label_line = graph.max_fixed_label_line;
+    header.neighbors_count = graph.neighbor_offsets[graph.vertex_count];
+    header.constraints_count = graph.constraint_offsets[graph.vertex_count];
+
+    file.write((char*) &header, GRAPH_FILE_HEADER_SIZE);
+    file.write((char*) graph.neighbor_offsets, sizeof(int) * (graph.vertex_count + 1));
+    file.write((char*) graph.neighbors, sizeof(int) * header.neighbors_count);
+    file.write((char*) graph.constraint_offsets, sizeof(int) * (graph.vertex_count + 1));
+    file.write((char*) graph.constraint_vertexes, sizeof(int) * header.constraints_count);
+    file.write((char*) graph.solution_backbone, sizeof(int) * graph.vertex_count);
+    file.write((char*) graph.free_vertexes, sizeof(int) * (graph.vertex_count - graph.fixed_vertex_count));
+
+    file.close();
+
+    if(!file || rename(temporary_path.str().c_str(), file_path) != 0)
+    {
+        remove(temporary_path.str().c_str());
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,27 @@
+/*  Borsos Barna
+
+    Binary graph file. It holds the arrays of a built graph, so loading
+    it is a single mmap(): the graph points into the mapping and nothing
+    is parsed or copied. The mapping is read only.
+
+    GRAPH FILE (native byte order)
+        magic number GRAPH_FILE_MAGIC (64 bit), format version GRAPH_FILE_VERSION
+        vertex count, edge count, predefined vertex count, greatest predefined label,
+        line of the greatest predefined label, neighbors count, constraint vertexes count (32 bit integers)
+        neighbor offsets, neighbors, constraint offsets, constraint vertexes,
+        solution backbone, free vertexes (32 bit integer arrays)
+*/
+
+#ifndef LABELING_GRAPH_FILE_H
+#define LABELING_GRAPH_FILE_H
+
+#include "labeling/graph.h"
+
+#define GRAPH_FILE_MAGIC 0x4850524743424c47ULL   // "GLBCGRPH"
+#define GRAPH_FILE_VERSION 3
+
+bool map_graph_file(const char*, graph&);
+void unmap_graph_file(graph&);
+bool write_graph_file(const char*, graph&);
+
+#endif
@@ -0,0 +1,35 @@
+/*  Borsos Barna */
+
+#include "labeling/options.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+using namespace std;
+
+const char* get_option(int argc, char** argv, int first, const char* name)
+{
+    /* options start after the positional arguments */
+    for(int i = first; i < argc; ++i)
+    {
+        if(strncmp(argv[i], "--", 2) == 0 && strcmp(argv[i] + 2, name) == 0)
+        {
+            if(i + 1 >= argc)
+            {
+                throw invalid_argument(name);
+            }
+
+            return argv[i + 1];
+        }
+    }
+
+    return NULL;
+}
+
+int get_option(int argc, char** argv, int first, const char* name, int default_value)
+{
+    const char* value = get_option(argc, argv, first, name);
+
+    return value ? atoi(value) : default_value;
+}
@@ -0,0 +1,13 @@
+/*  Borsos Barna
+
+    Optional "--name value" command line arguments, given after the
+    positional arguments of an algorithm.
+*/
+
+#ifndef LABELING_OPTIONS_H
+#define LABELING_OPTIONS_H
+
+const char* get_option(int, char**, int, const char*);
+int get_option(int, char**, int, const char*, int);
+
+#endif
@@ -0,0 +1,60 @@
+/*  Borsos Barna */
+
+#include "labeling/progress.h"
+
+#include <cstdint>
+
+#include "labeling/stats.h"
+#include "labeling/timer.h"
+
+using namespace std;
+
+void start_progress(progress& progress, ostream* output)
+{
+    progress.output = output;
+    progress.fitness = -1;
+    progress.time = -PROGRESS_INTERVAL;
+}
+
+template<typename label_type>
+void report_progress(progress& progress, double start_time, int iterations, graph& graph, solution<label_type>& solution)
+{
+    if(!progress.output)
+    {
+        return;
+    }
+
+    lock_guard<mutex> guard(progress.lock);
+    double time = elapsed_time(start_time);
+
+    if(solution.fitness <= progress.fitness || time - progress.time < PROGRESS_INTERVAL)
+    {
+        return;
+    }
+
+    progress.fitness = solution.fitness;
+    progress.time = time;
+
+    ostream& output = *progress.output;
+
+    output << "{\"time\":" << json_number(time) << ",\"iterations\":" << iterations << ",\"solution\":\"";
+
+    /* the narrow label types would be printed as characters */
+    for(int i = 0; i < graph.vertex_count; ++i)
+    {
+        output << (i ? " " : "") << (int) solution.labels[i];
+    }
+
+    output << "\",\"isCorrect\":" << (solution.is_correct ? "true" : "false");
+    output << ",\"conflictingVertexes\":" << solution.conflicting_vertexes;
+    output << ",\"chromaticNumber\":" << solution.chromatic_number;
+    output << ",\"fitness\":" << json_number(solution.fitness) << '}' << endl;
+}
+
+#define INSTANTIATE_PROGRESS(label_type) \
+    template void report_progress(progress&, double, int, graph&, solution<label_type>&);
+
+/* the label types of the algorithms */
+INSTANTIATE_PROGRESS(uint8_t)
+INSTANTIATE_PROGRESS(uint16_t)
+INSTANTIATE_PROGRESS(int)
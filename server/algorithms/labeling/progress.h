@@ -0,0 +1,40 @@
+/*  Borsos Barna
+
+    Progress of a run. With --progress 1 the algorithms report their
+    best solution regularly, and a record is written ahead of their
+    output whenever it improved, at most one in every PROGRESS_INTERVAL
+    seconds. A record is one line of JSON with the fields of the
+    responses of the controllers:
+
+        {"time":0.25,"iterations":1200,"solution":"1 5 3","isCorrect":false,
+         "conflictingVertexes":2,"chromaticNumber":12,"fitness":0.93}
+
+    The threads of a run report to the same progress, which only writes
+    a record if the solution is fitter than the last one written. The
+    daemon sends the records of a job as soon as they are written, see
+    labeling/daemon.h.
+*/
+
+#ifndef LABELING_PROGRESS_H
+#define LABELING_PROGRESS_H
+
+#include <mutex>
+#include <ostream>
+
+#include "labeling/graph.h"
+#include "labeling/solution.h"
+
+#define PROGRESS_INTERVAL 0.1       // min. time between two records (seconds)
+
+struct progress
+{
+    std::ostream* output;           // stream of the records (NULL: no records)
+    std::mutex lock;                // the threads of a run report one at a time
+    double fitness;                 // fitness of the last record
+    double time;                    // time of the last record
+};
+
+void start_progress(progress&, std::ostream*);
+template<typename label_type> void report_progress(progress&, double, int, graph&, solution<label_type>&);
+
+#endif
@@ -0,0 +1,68 @@
+/*  Borsos Barna */
+
+#include "labeling/random.h"
+
+#include <chrono>
+#include <random>
+
+using namespace std;
+
+static uint64_t splitmix64(uint64_t& value)
+{
+    uint64_t z = (value += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+
+    return z ^ (z >> 31);
+}
+
+static void jump(random_generator& generator)
+{
+    /* advance the generator by 2^128 steps */
+    static const uint64_t polynomial[] = { 0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL,
+                                           0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL };
+    uint64_t jumped[4] = { 0, 0, 0, 0 };
+
+    for(int i = 0; i < 4; ++i)
+    {
+        for(int bit = 0; bit < 64; ++bit)
+        {
+            if(polynomial[i] & (1ULL << bit))
+            {
+                for(int j = 0; j < 4; ++j)
+                {
+                    jumped[j] ^= generator.state[j];
+                }
+            }
+
+            random_next(generator);
+        }
+    }
+
+    for(int j = 0; j < 4; ++j)
+    {
+        generator.state[j] = jumped[j];
+    }
+}
+
+uint64_t random_seed()
+{
+    /* runs started in the same second, like the jobs of a daemon, still get different seeds */
+    random_device device;
+
+    return ((uint64_t) device() << 32 ^ device()) ^ chrono::steady_clock::now().time_since_epoch().count();
+}
+
+void seed_generator(random_generator& generator, uint64_t seed, int stream)
+{
+    /* expand the seed into the state, then move to the start of the stream */
+    for(int i = 0; i < 4; ++i)
+    {
+        generator.state[i] = splitmix64(seed);
+    }
+
+    for(int i = 0; i < stream; ++i)
+    {
+        jump(generator);
+    }
+}
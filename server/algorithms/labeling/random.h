@@ -0,0 +1,56 @@
+/*  Borsos Barna
+
+    xoshiro256** pseudo random number generator (Blackman, Vigna).
+
+    Every thread uses its own generator. Generators seeded with the same
+    seed and different streams produce non-overlapping sequences, so a run
+    is reproducible from its seed regardless of the number of threads.
+*/
+
+#ifndef LABELING_RANDOM_H
+#define LABELING_RANDOM_H
+
+#include <cstdint>
+
+struct random_generator
+{
+    uint64_t state[4];              // generator state, never all zero
+};
+
+uint64_t random_seed();
+void seed_generator(random_generator&, uint64_t, int);
+
+inline uint64_t rotate_left(uint64_t value, int bits)
+{
+    return (value << bits) | (value >> (64 - bits));
+}
+
+inline uint64_t random_next(random_generator& generator)
+{
+    uint64_t* s = generator.state;
+    uint64_t result = rotate_left(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotate_left(s[3], 45);
+
+    return result;
+}
+
+/* uniform integer in [0, n), n > 0 (multiply-shift range reduction) */
+inline int random_int(random_generator& generator, int n)
+{
+    return (int) (((random_next(generator) >> 32) * (uint64_t) n) >> 32);
+}
+
+/* uniform real number in [0, 1) */
+inline double random_double(random_generator& generator)
+{
+    return (random_next(generator) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+#endif
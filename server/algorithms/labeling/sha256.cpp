@@ -0,0 +1,138 @@
+/*  Borsos Barna */
+
+#include "labeling/sha256.h"
+
+#include <cstring>
+
+using namespace std;
+
+static const uint32_t ROUND_CONSTANTS[64] =
+{
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+static inline uint32_t rotate_right(uint32_t value, int bits)
+{
+    return (value >> bits) | (value << (32 - bits));
+}
+
+static void process_block(sha256& hash, const unsigned char* block)
+{
+    uint32_t w[64];
+
+    for(int i = 0; i < 16; ++i)
+    {
+        w[i] = (uint32_t) block[4 * i] << 24 | (uint32_t) block[4 * i + 1] << 16 |
+               (uint32_t) block[4 * i + 2] << 8 | (uint32_t) block[4 * i + 3];
+    }
+
+    for(int i = 16; i < 64; ++i)
+    {
+        uint32_t s0 = rotate_right(w[i - 15], 7) ^ rotate_right(w[i - 15], 18) ^ (w[i - 15] >> 3);
+        uint32_t s1 = rotate_right(w[i - 2], 17) ^ rotate_right(w[i - 2], 19) ^ (w[i - 2] >> 10);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+
+    uint32_t v[8];
+    memcpy(v, hash.state, sizeof(v));
+
+    for(int i = 0; i < 64; ++i)
+    {
+        uint32_t s1 = rotate_right(v[4], 6) ^ rotate_right(v[4], 11) ^ rotate_right(v[4], 25);
+        uint32_t choice = (v[4] & v[5]) ^ (~v[4] & v[6]);
+        uint32_t t1 = v[7] + s1 + choice + ROUND_CONSTANTS[i] + w[i];
+        uint32_t s0 = rotate_right(v[0], 2) ^ rotate_right(v[0], 13) ^ rotate_right(v[0], 22);
+        uint32_t majority = (v[0] & v[1]) ^ (v[0] & v[2]) ^ (v[1] & v[2]);
+        uint32_t t2 = s0 + majority;
+
+        v[7] = v[6];
+        v[6] = v[5];
+        v[5] = v[4];
+        v[4] = v[3] + t1;
+        v[3] = v[2];
+        v[2] = v[1];
+        v[1] = v[0];
+        v[0] = t1 + t2;
+    }
+
+    for(int i = 0; i < 8; ++i)
+    {
+        hash.state[i] += v[i];
+    }
+}
+
+void sha256_start(sha256& hash)
+{
+    static const uint32_t initial_state[8] =
+    {
+        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+    };
+
+    memcpy(hash.state, initial_state, sizeof(hash.state));
+    hash.length = 0;
+}
+
+void sha256_update(sha256& hash, const void* data, size_t size)
+{
+    const unsigned char* bytes = (const unsigned char*) data;
+    size_t used = hash.length % 64;
+
+    hash.length += size;
+
+    /* the unfinished block first, then whole blocks straight from the data */
+    if(used)
+    {
+        size_t count = size < 64 - used ? size : 64 - used;
+        memcpy(hash.block + used, bytes, count);
+        bytes += count;
+        size -= count;
+
+        if(used + count < 64)
+        {
+            return;
+        }
+
+        process_block(hash, hash.block);
+    }
+
+    for(; size >= 64; bytes += 64, size -= 64)
+    {
+        process_block(hash, bytes);
+    }
+
+    memcpy(hash.block, bytes, size);
+}
+
+string sha256_hex(sha256& hash)
+{
+    /* padding: a one bit, zeros and the length in bits, the hash can not be updated after */
+    uint64_t bits = hash.length * 8;
+    unsigned char padding[72] = {0x80};
+    size_t padding_size = (hash.length % 64 < 56 ? 56 : 120) - hash.length % 64;
+
+    for(int i = 0; i < 8; ++i)
+    {
+        padding[padding_size + i] = (unsigned char) (bits >> (56 - 8 * i));
+    }
+
+    sha256_update(hash, padding, padding_size + 8);
+
+    static const char digits[] = "0123456789abcdef";
+    string hex(64, '0');
+
+    for(int i = 0; i < 32; ++i)
+    {
+        unsigned char byte = (unsigned char) (hash.state[i / 4] >> (24 - 8 * (i % 4)));
+        hex[2 * i] = digits[byte >> 4];
+        hex[2 * i + 1] = digits[byte & 15];
+    }
+
+    return hex;
+}
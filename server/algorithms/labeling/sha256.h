@@ -0,0 +1,26 @@
+/*  Borsos Barna
+
+    SHA-256 (FIPS 180-4) of a byte stream, for the keys of the graph
+    cache. The cache is shared by every user of the server, so two inputs
+    must never get the same key.
+*/
+
+#ifndef LABELING_SHA256_H
+#define LABELING_SHA256_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+struct sha256
+{
+    uint32_t state[8];              // hash of the processed blocks
+    uint64_t length;                // bytes hashed so far
+    unsigned char block[64];        // bytes of the unfinished block
+};
+
+void sha256_start(sha256&);
+void sha256_update(sha256&, const void*, size_t);
+std::string sha256_hex(sha256&);
+
+#endif
@@ -0,0 +1,197 @@
+/*  Borsos Barna */
+
+#include "labeling/solution.h"
+
+#include <cstdlib>
+#include <algorithm>
+#include <new>
+
+using namespace std;
+
+static size_t arena_stride(size_t);
+static char* allocate_arena(size_t);
+
+void check_fixed_labels(constraints& constraints, graph& graph)
+{
+    /* the graph is cached without the max. label, so its predefined labels are checked for every run */
+    if(graph.max_fixed_label > constraints.max_label)
+    {
+        throw input_error(graph.max_fixed_label_line);
+    }
+}
+
+int label_count_size(constraints& constraints, graph& graph)
+{
+    /* labels above max. label can only come from the predefined vertexes */
+    return max(constraints.max_label, graph.max_fixed_label) + 1;
+}
+
+template<typename label_type>
+void allocate_solution(constraints& constraints, graph& graph, solution<label_type>& solution, bool tracked)
+{
+    solution.labels = new label_type[graph.vertex_count + LABEL_PADDING];
+    solution.conflicts = NULL;
+    solution.label_count = NULL;
+    solution.conflict_set = NULL;
+    solution.conflict_position = NULL;
+
+    if(tracked)
+    {
+        solution.conflicts = new int[graph.vertex_count];
+        solution.label_count = new int[label_count_size(constraints, graph)];
+        solution.conflict_set = new int[graph.vertex_count];
+        solution.conflict_position = new int[graph.vertex_count];
+    }
+
+    solution.fitness = -1;
+}
+
+template<typename label_type>
+void free_solution(solution<label_type>& solution)
+{
+    delete[] solution.labels;
+    delete[] solution.conflicts;
+    delete[] solution.label_count;
+    delete[] solution.conflict_set;
+    delete[] solution.conflict_position;
+}
+
+template<typename label_type>
+void allocate_solutions(constraints& constraints, graph& graph, solution<label_type>* solutions, int count, bool tracked)
+{
+    /* every array kind of the solutions is cut from one arena, every piece starts at a cache line */
+    size_t labels_stride = arena_stride((graph.vertex_count + LABEL_PADDING) * sizeof(label_type));
+    size_t stride = arena_stride(graph.vertex_count * sizeof(int));
+    size_t label_count_stride = arena_stride(label_count_size(constraints, graph) * sizeof(int));
+
+    char* labels = allocate_arena(labels_stride * count);
+    char* conflicts = tracked ? allocate_arena(stride * count) : NULL;
+    char* label_count = tracked ? allocate_arena(label_count_stride * count) : NULL;
+    char* conflict_set = tracked ? allocate_arena(stride * count) : NULL;
+    char* conflict_position = tracked ? allocate_arena(stride * count) : NULL;
+
+    for(int i = 0; i < count; ++i)
+    {
+        solutions[i].labels = (label_type*) (labels + i * labels_stride);
+        solutions[i].conflicts = tracked ? (int*) (conflicts + i * stride) : NULL;
+        solutions[i].label_count = tracked ? (int*) (label_count + i * label_count_stride) : NULL;
+        solutions[i].conflict_set = tracked ? (int*) (conflict_set + i * stride) : NULL;
+        solutions[i].conflict_position = tracked ? (int*) (conflict_position + i * stride) : NULL;
+        solutions[i].fitness = -1;
+    }
+}
+
+template<typename label_type>
+void free_solutions(solution<label_type>* solutions, int count)
+{
+    /* the first solution starts every arena */
+    if(count > 0)
+    {
+        free(solutions[0].labels);
+        free(solutions[0].conflicts);
+        free(solutions[0].label_count);
+        free(solutions[0].conflict_set);
+        free(solutions[0].conflict_position);
+    }
+}
+
+template<typename label_type>
+void random_solution(constraints& constraints, graph& graph, solution<label_type>& solution, random_generator& generator)
+{
+    for(int i = 0; i < graph.vertex_count; ++i)
+    {
+        if(graph.solution_backbone[i])
+        {
+            solution.labels[i] = graph.solution_backbone[i];
+        }
+        else
+        {
+            solution.labels[i] = random_int(generator, constraints.max_label) + 1;
+        }
+    }
+}
+
+template<typename label_type>
+void copy_evaluation(solution<label_type>& source, solution<label_type>& destination)
+{
+    destination.is_correct = source.is_correct;
+    destination.conflicting_vertexes = source.conflicting_vertexes;
+    destination.conflicting_fixed = source.conflicting_fixed;
+    destination.chromatic_number = source.chromatic_number;
+    destination.fitness = source.fitness;
+}
+
+template<typename label_type>
+void copy_solution(graph& graph, solution<label_type>& source, solution<label_type>& destination)
+{
+    copy(source.labels, source.labels + graph.vertex_count, destination.labels);
+    copy_evaluation(source, destination);
+}
+
+template<typename label_type>
+void copy_tracked_solution(constraints& constraints, graph& graph, solution<label_type>& source, solution<label_type>& destination)
+{
+    copy(source.conflicts, source.conflicts + graph.vertex_count, destination.conflicts);
+    copy(source.label_count, source.label_count + label_count_size(constraints, graph), destination.label_count);
+    copy(source.conflict_set, source.conflict_set + source.conflicting_vertexes, destination.conflict_set);
+    copy(source.conflict_position, source.conflict_position + graph.vertex_count, destination.conflict_position);
+    copy_solution(graph, source, destination);
+}
+
+template<typename label_type>
+void print_solution(ostream& output, graph& graph, solution<label_type>& solution)
+{
+    /* the narrow label types would be printed as characters */
+    for(int i = 0; i < graph.vertex_count; ++i)
+    {
+        output << (int) solution.labels[i] << ' ';
+    }
+    output << endl;
+
+    output << solution.is_correct << endl;
+    output << solution.conflicting_vertexes << endl;
+    output << solution.chromatic_number << endl;
+    output << solution.fitness << endl;
+}
+
+template<typename label_type>
+int random_conflicting_vertex(solution<label_type>& solution, random_generator& generator)
+{
+    /* the tracked solution must have at least one conflicting non-fixed vertex */
+    return solution.conflict_set[random_int(generator, solution.conflicting_vertexes)];
+}
+
+static size_t arena_stride(size_t size)
+{
+    /* round up to whole cache lines */
+    return (size + SOLUTION_ALIGNMENT - 1) / SOLUTION_ALIGNMENT * SOLUTION_ALIGNMENT;
+}
+
+static char* allocate_arena(size_t size)
+{
+    void* arena;
+
+    if(posix_memalign(&arena, SOLUTION_ALIGNMENT, max(size, (size_t) 1)) != 0)
+    {
+        throw bad_alloc();
+    }
+
+    return (char*) arena;
+}
+
+#define INSTANTIATE_SOLUTION(label_type) \
+    template void allocate_solution(constraints&, graph&, solution<label_type>&, bool); \
+    template void free_solution(solution<label_type>&); \
+    template void allocate_solutions(constraints&, graph&, solution<label_type>*, int, bool); \
+    template void free_solutions(solution<label_type>*, int); \
+    template void random_solution(constraints&, graph&, solution<label_type>&, random_generator&); \
+    template void copy_evaluation(solution<label_type>&, solution<label_type>&); \
+    template void copy_solution(graph&, solution<label_type>&, solution<label_type>&); \
+    template void copy_tracked_solution(constraints&, graph&, solution<label_type>&, solution<label_type>&); \
+    template void print_solution(ostream&, graph&, solution<label_type>&); \
+    template int random_conflicting_vertex(solution<label_type>&, random_generator&);
+
+/* the label types of the algorithms */
+INSTANTIATE_SOLUTION(uint8_t)
+INSTANTIATE_SOLUTION(uint16_t)
+INSTANTIATE_SOLUTION(int)
@@ -0,0 +1,72 @@
+/*  Borsos Barna
+
+    Labeling of a graph together with its evaluation.
+
+    A tracked solution also keeps the number of violated constraints of
+    every vertex and a histogram of the labels, which lets relabel()
+    update the evaluation by visiting only the neighborhood of the
+    changed vertex. The conflicting non-fixed vertexes are kept in an
+    indexed set: the first conflicting_vertexes entries of conflict_set,
+    with the place of every vertex in conflict_position, so a random one
+    is picked, added or removed in constant time.
+
+    allocate_solutions() places many solutions side by side: every array
+    kind of them is one aligned arena instead of an allocation each, and
+    they are freed together by free_solutions().
+
+    The labels are stored in the narrowest type holding max. label
+    (uint8_t, uint16_t or int), so the solutions and everything working
+    on them are templates of the label type. The algorithms pick the
+    type once, when the run starts.
+*/
+
+#ifndef LABELING_SOLUTION_H
+#define LABELING_SOLUTION_H
+
+#include <cstdint>
+#include <ostream>
+
+#include "labeling/graph.h"
+#include "labeling/random.h"
+
+#define SOLUTION_ALIGNMENT 64       // alignment of the arrays of solutions allocated together (bytes)
+#define LABEL_PADDING 4             // labels allocated after the last vertex, wide loads may read into them
+
+struct constraints
+{
+    int h;                          // min. difference between adjacent vertexes
+    int k;                          // min. difference between vertexes at distance of 2 edges
+    int max_label;                  // max. value of a label
+};
+
+template<typename label_type>
+struct solution
+{
+    label_type* labels;             // proposed solution
+    int* conflicts;                 // number of violated constraints of every vertex (tracked only)
+    int* label_count;               // number of vertexes using every label (tracked only)
+    int* conflict_set;              // conflicting non-fixed vertexes (tracked only)
+    int* conflict_position;         // place of every vertex in the conflict set, -1 if absent (tracked only)
+
+    bool is_correct;                // solution correctness
+    int conflicting_vertexes;       // solution conflicting vertexes count
+    int conflicting_fixed;          // solution conflicting predefined vertexes count
+    int chromatic_number;           // solution chromatic number
+    double fitness;                 // solution fitness
+};
+
+void check_fixed_labels(constraints&, graph&);
+int label_count_size(constraints&, graph&);
+
+template<typename label_type> void allocate_solution(constraints&, graph&, solution<label_type>&, bool);
+template<typename label_type> void free_solution(solution<label_type>&);
+template<typename label_type> void allocate_solutions(constraints&, graph&, solution<label_type>*, int, bool);
+template<typename label_type> void free_solutions(solution<label_type>*, int);
+template<typename label_type> void random_solution(constraints&, graph&, solution<label_type>&, random_generator&);
+template<typename label_type> void copy_evaluation(solution<label_type>&, solution<label_type>&);
+template<typename label_type> void copy_solution(graph&, solution<label_type>&, solution<label_type>&);
+template<typename label_type> void copy_tracked_solution(constraints&, graph&, solution<label_type>&, solution<label_type>&);
+template<typename label_type> void print_solution(std::ostream&, graph&, solution<label_type>&);
+template<typename label_type> int random_conflicting_vertex(solution<label_type>&, random_generator&);
+
+#endif
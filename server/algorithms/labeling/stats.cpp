@@ -0,0 +1,87 @@
+/*  Borsos Barna */
+
+#include "labeling/stats.h"
+
+#include <sys/resource.h>
+#include <cmath>
+#include <sstream>
+
+#include "labeling/timer.h"
+
+using namespace std;
+
+void start_stats(stats& stats, bool enabled, double start_time)
+{
+    stats.enabled = enabled;
+    stats.phase_start = start_time;
+
+    for(int i = 0; i < PHASE_COUNT; ++i)
+    {
+        stats.phase_times[i] = 0;
+    }
+}
+
+void end_phase(stats& stats, stats_phase phase)
+{
+    if(!stats.enabled)
+    {
+        return;
+    }
+
+    /* the next phase starts where this one ends */
+    double time = current_time();
+
+    stats.phase_times[phase] += time - stats.phase_start;
+    stats.phase_start = time;
+}
+
+void write_stats(ostream& output, stats& stats, const string& counters)
+{
+    if(!stats.enabled)
+    {
+        return;
+    }
+
+    /* the output phase ends with the output of the algorithm */
+    end_phase(stats, OUTPUT_PHASE);
+
+    output << "{\"phases\":{\"load\":" << json_number(stats.phase_times[LOAD_PHASE]);
+    output << ",\"preprocess\":" << json_number(stats.phase_times[PREPROCESS_PHASE]);
+    output << ",\"search\":" << json_number(stats.phase_times[SEARCH_PHASE]);
+    output << ",\"output\":" << json_number(stats.phase_times[OUTPUT_PHASE]) << '}';
+    output << ",\"processPeakMemory\":" << peak_memory();
+
+    if(!counters.empty())
+    {
+        output << ',' << counters;
+    }
+
+    output << '}' << endl;
+}
+
+size_t peak_memory()
+{
+    struct rusage usage;
+
+    if(getrusage(RUSAGE_SELF, &usage) != 0)
+    {
+        return 0;
+    }
+
+    /* kilobytes on Linux */
+    return (size_t) usage.ru_maxrss * 1024;
+}
+
+string json_number(double value)
+{
+    /* inf and nan would make the line invalid JSON */
+    if(!isfinite(value))
+    {
+        return "null";
+    }
+
+    ostringstream number;
+    number << value;
+
+    return number.str();
+}
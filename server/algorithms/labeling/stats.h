@@ -0,0 +1,54 @@
+/*  Borsos Barna
+
+    Statistics of a run. With --stats 1 the algorithms measure where the
+    time of the run goes and count what their search did, and write it
+    after their output as one line of JSON:
+
+        {"phases":{"load":0.02,"preprocess":0.001,"search":1.5,"output":0.0004},
+         "processPeakMemory":10485760, ...the counters of the algorithm...}
+
+    The phases follow each other: the load phase reads the graph (a
+    daemon job gets its graph loaded, so it is short), the preprocess
+    phase prepares the search (initial solutions and their evaluation),
+    the search phase runs the algorithm and the output phase writes the
+    result. The process peak memory is the max. resident set size of the
+    whole process so far, not of the run alone: in daemon mode it is the
+    peak of the daemon, every job before and beside the run included.
+
+    Numbers that are not finite (an infinite start temperature, for
+    example) are written as null, JSON has no value for them.
+
+    The counters are only updated when the statistics are enabled, the
+    algorithms pay a predictable branch for them otherwise.
+*/
+
+#ifndef LABELING_STATS_H
+#define LABELING_STATS_H
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+
+enum stats_phase
+{
+    LOAD_PHASE,
+    PREPROCESS_PHASE,
+    SEARCH_PHASE,
+    OUTPUT_PHASE,
+    PHASE_COUNT
+};
+
+struct stats
+{
+    bool enabled;                       // statistics are measured and written
+    double phase_start;                 // start of the current phase
+    double phase_times[PHASE_COUNT];    // time spent in every phase (seconds)
+};
+
+void start_stats(stats&, bool, double);
+void end_phase(stats&, stats_phase);
+void write_stats(std::ostream&, stats&, const std::string&);
+size_t peak_memory();
+std::string json_number(double);
+
+#endif
@@ -0,0 +1,71 @@
+/*  Borsos Barna */
+
+#include "labeling/timer.h"
+
+#include <chrono>
+#include <cmath>
+#include <csignal>
+#include <algorithm>
+
+using namespace std;
+
+static atomic<bool> signalled(false);                  // SIGTERM or SIGINT arrived
+static thread_local const atomic<bool>* cancel_flag;   // cancel flag of the runs started on the thread
+
+static void cancel_runs(int);
+
+double current_time()
+{
+    /* seconds on a clock which is never adjusted */
+    return chrono::duration<double>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+double elapsed_time(double start_time)
+{
+    return current_time() - start_time;
+}
+
+int64_t current_milliseconds()
+{
+    return chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void set_deadline(deadline& deadline, double start_time, double seconds, int interval)
+{
+    /* the run ends max. running time after its start, which is on the clock of current_time() */
+    deadline.end = llround((start_time + max(0.0, min(seconds, MAX_RUNNING_TIME))) * 1000);
+    deadline.interval = max(1, interval);
+    deadline.countdown = 1;
+    deadline.expired = false;
+    deadline.cancelled = cancel_flag;
+}
+
+bool is_expired(deadline& deadline)
+{
+    /* reads the clock at once, e.g. when the threads of a run meet */
+    deadline.expired = deadline.expired || signalled || (deadline.cancelled && *deadline.cancelled) ||
+                       current_milliseconds() >= deadline.end;
+    return deadline.expired;
+}
+
+void cancel_on_signals()
+{
+    /* without SA_RESTART a blocking read is interrupted, so the daemon stops reading jobs */
+    struct sigaction action = {};
+    action.sa_handler = cancel_runs;
+    action.sa_flags = SA_RESETHAND;
+    sigemptyset(&action.sa_mask);
+
+    sigaction(SIGTERM, &action, NULL);
+    sigaction(SIGINT, &action, NULL);
+}
+
+void set_cancel_flag(const atomic<bool>* flag)
+{
+    cancel_flag = flag;
+}
+
+static void cancel_runs(int)
+{
+    signalled = true;
+}
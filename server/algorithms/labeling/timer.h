@@ -0,0 +1,57 @@
+/*  Borsos Barna
+
+    Wall-clock time of a run. clock() measures the CPU time of the
+    whole process, which grows faster than real time once the algorithms
+    use several threads, and a daemon runs many jobs in one process.
+
+    A deadline ends a run on the same clock with millisecond resolution.
+    The loops of the algorithms ask it at every iteration, but it reads
+    the clock only at every interval-th question, so it costs a counter
+    decrement in between. A deadline is asked by a single thread, every
+    thread of a run has its own copy.
+
+    A cancelled run reaches its deadline at the next reading of the
+    clock, so the algorithms finish the iteration they are in and write
+    their output as usual. After cancel_on_signals() SIGTERM and SIGINT
+    cancel every run of the process (a second signal kills it). A daemon
+    job is cancelled alone by its own flag, given to set_cancel_flag() on
+    the thread which starts the job.
+*/
+
+#ifndef LABELING_TIMER_H
+#define LABELING_TIMER_H
+
+#include <atomic>
+#include <cstdint>
+
+#define MAX_RUNNING_TIME 1e9        // longest run of a deadline (seconds)
+
+struct deadline
+{
+    int64_t end;                        // end of the run on the steady clock (milliseconds)
+    int interval;                       // questions between two readings of the clock
+    int countdown;                      // questions left until the clock is read again
+    bool expired;                       // the end was reached
+    const std::atomic<bool>* cancelled; // cancel flag of the run (NULL: only the signals cancel it)
+};
+
+double current_time();
+double elapsed_time(double);
+int64_t current_milliseconds();
+void set_deadline(deadline&, double, double, int);
+bool is_expired(deadline&);
+void cancel_on_signals();
+void set_cancel_flag(const std::atomic<bool>*);
+
+inline bool time_is_up(deadline& deadline)
+{
+    if(--deadline.countdown > 0)
+    {
+        return deadline.expired;
+    }
+
+    deadline.countdown = deadline.interval;
+    return is_expired(deadline);
+}
+
+#endif
@@ -0,0 +1,67 @@
+/* Compares the crossover operators of the genetic algorithm: the generations and the time
+   needed for the first correct solution, averaged over runs with fixed seeds.
+
+   node server/benchmarks/crossover.js file h k maxLabel [runs] [maxGenerations] [maxTime]
+*/
+
+const path = require('path');
+const { spawnSync } = require('child_process');
+
+const OPERATORS = ['uniform', 'block', 'one-point', 'two-point', 'conflict'];
+const POPULATIONS_COUNT = 2;
+const POPULATION_SIZE = 60;
+const MUTATION_CHANCE = 0.5;
+const ELITES = 2;
+
+const executable = path.join(__dirname, '..', 'bin', 'GeneticAlgorithm');
+const [file, h, k, maxLabel, runs = '5', maxGenerations = '2000', maxTime = '60'] = process.argv.slice(2);
+
+function runOperator(operator, seed) {
+  const args = [h, k, file, maxLabel, POPULATIONS_COUNT, POPULATION_SIZE, MUTATION_CHANCE, ELITES,
+    maxGenerations, maxTime, '--seed', seed, '--crossover', operator, '--stop-feasible', 1];
+  const result = spawnSync(executable, args.map(String), { encoding: 'utf8' });
+  const lines = result.stdout.split('\n');
+
+  if (result.status !== 0) {
+    throw new Error(`${operator}: ${lines[0]}`);
+  }
+
+  /* time elapsed, generations created, correctness and conflicting vertexes of the output */
+  return {
+    time: parseFloat(lines[0]),
+    generations: parseInt(lines[1], 10),
+    feasible: lines[3] === '1',
+    conflicts: parseInt(lines[4], 10),
+  };
+}
+
+function average(values, digits) {
+  return values.length ? (values.reduce((sum, value) => sum + value, 0) / values.length).toFixed(digits) : '-';
+}
+
+if (!maxLabel) {
+  console.log('usage: node crossover.js file h k maxLabel [runs] [maxGenerations] [maxTime]');
+  process.exit(1);
+}
+
+console.log('operator    feasible  generations  time (s)  conflicts');
+
+OPERATORS.forEach((operator) => {
+  const results = [];
+
+  for (let seed = 1; seed <= parseInt(runs, 10); seed += 1) {
+    results.push(runOperator(operator, seed));
+  }
+
+  /* generations and time to feasible count the feasible runs, conflicts the others */
+  const feasible = results.filter(result => result.feasible);
+  const infeasible = results.filter(result => !result.feasible);
+
+  console.log([
+    operator.padEnd(10),
+    `${feasible.length}/${results.length}`.padStart(8),
+    average(feasible.map(result => result.generations), 1).padStart(12),
+    average(feasible.map(result => result.time), 3).padStart(9),
+    average(infeasible.map(result => result.conflicts), 1).padStart(10),
+  ].join('  '));
+});
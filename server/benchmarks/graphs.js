@@ -0,0 +1,194 @@
+/* Generators of the benchmark graph families, written in the input file format of the solvers
+   (vertex count, edge count and predefined vertex count, then the edges with 1-based vertexes).
+   The random families are generated from a fixed seed, so every run gets the same graphs.
+
+   node server/benchmarks/graphs.js family size [seed] > graph.in
+*/
+
+const AVERAGE_DEGREE = 6;        // expected degree of the G(n, p) graphs
+const RADIO_DEGREE = 8;          // expected degree of the unit disk graphs (ignoring the border)
+const PETERSEN_STEP = 3;         // inner cycle step of the generalised Petersen graphs
+
+/* small 32 bit generator (mulberry32), the same seed gives the same numbers on every platform */
+function randomGenerator(seed) {
+  let state = seed >>> 0;
+
+  return () => {
+    state = (state + 0x6D2B79F5) >>> 0;
+    let value = state;
+    value = Math.imul(value ^ (value >>> 15), value | 1);
+    value ^= value + Math.imul(value ^ (value >>> 7), value | 61);
+    return ((value ^ (value >>> 14)) >>> 0) / 4294967296;
+  };
+}
+
+/* side x side grid, every vertex joined to its horizontal and vertical neighbors */
+function grid(side) {
+  const edges = [];
+
+  for (let row = 0; row < side; row += 1) {
+    for (let column = 0; column < side; column += 1) {
+      const vertex = (row * side) + column;
+
+      if (column + 1 < side) {
+        edges.push([vertex, vertex + 1]);
+      }
+      if (row + 1 < side) {
+        edges.push([vertex, vertex + side]);
+      }
+    }
+  }
+
+  return { vertexCount: side * side, edges };
+}
+
+/* dimension dimensional hypercube, the vertexes differing in one bit are neighbors */
+function hypercube(dimension) {
+  const vertexCount = 2 ** dimension;
+  const edges = [];
+
+  for (let vertex = 0; vertex < vertexCount; vertex += 1) {
+    for (let bit = 0; bit < dimension; bit += 1) {
+      const neighbor = vertex ^ (1 << bit);
+
+      if (vertex < neighbor) {
+        edges.push([vertex, neighbor]);
+      }
+    }
+  }
+
+  return { vertexCount, edges };
+}
+
+/* Erdős–Rényi G(n, p) graph with p = AVERAGE_DEGREE / (n - 1) */
+function gnp(vertexCount, seed) {
+  const random = randomGenerator(seed);
+  const p = Math.min(1, AVERAGE_DEGREE / (vertexCount - 1));
+  const edges = [];
+
+  for (let a = 0; a < vertexCount; a += 1) {
+    for (let b = a + 1; b < vertexCount; b += 1) {
+      if (random() < p) {
+        edges.push([a, b]);
+      }
+    }
+  }
+
+  return { vertexCount, edges };
+}
+
+/* unit disk ("radio") graph: random transmitters in the unit square, the ones
+   closer than the radius interfere, the radius gives RADIO_DEGREE neighbors */
+function unitDisk(vertexCount, seed) {
+  const random = randomGenerator(seed);
+  const radius = Math.sqrt(RADIO_DEGREE / (Math.PI * vertexCount));
+  const x = [];
+  const y = [];
+  const edges = [];
+
+  for (let i = 0; i < vertexCount; i += 1) {
+    x.push(random());
+    y.push(random());
+  }
+
+  for (let a = 0; a < vertexCount; a += 1) {
+    for (let b = a + 1; b < vertexCount; b += 1) {
+      if (((x[a] - x[b]) ** 2) + ((y[a] - y[b]) ** 2) < radius * radius) {
+        edges.push([a, b]);
+      }
+    }
+  }
+
+  return { vertexCount, edges };
+}
+
+/* generalised Petersen graph P(n, k): an outer cycle, spokes and an inner cycle of step k */
+function generalisedPetersen(n, k) {
+  const edges = [];
+
+  for (let i = 0; i < n; i += 1) {
+    edges.push([i, (i + 1) % n]);
+    edges.push([i, n + i]);
+    edges.push([n + i, n + ((i + k) % n)]);
+  }
+
+  return { vertexCount: 2 * n, edges };
+}
+
+/* benchmark families with their small, medium and large sizes */
+const FAMILIES = {
+  grid: { sizes: [10, 32, 100], generate: side => grid(side) },
+  hypercube: { sizes: [4, 7, 10], generate: dimension => hypercube(dimension) },
+  gnp: { sizes: [100, 1000, 10000], generate: (vertexCount, seed) => gnp(vertexCount, seed) },
+  'unit-disk': { sizes: [100, 1000, 5000], generate: (vertexCount, seed) => unitDisk(vertexCount, seed) },
+  petersen: { sizes: [5], generate: () => generalisedPetersen(5, 2) },
+  'generalised-petersen': { sizes: [50, 500, 5000], generate: n => generalisedPetersen(n, PETERSEN_STEP) },
+};
+
+/* greatest label of a first fit L(h, k) labeling (labels from 1), every instance with
+   this max. label has a correct solution */
+function greedySpan(graph, h, k) {
+  const neighbors = Array.from({ length: graph.vertexCount }, () => []);
+  const labels = new Array(graph.vertexCount).fill(0);
+  let span = 1;
+
+  graph.edges.forEach(([a, b]) => {
+    neighbors[a].push(b);
+    neighbors[b].push(a);
+  });
+
+  for (let vertex = 0; vertex < graph.vertexCount; vertex += 1) {
+    /* labels closer than the separation to a labeled neighbor or second neighbor are forbidden */
+    const forbidden = new Set();
+    const forbid = (label, separation) => {
+      for (let difference = 1 - separation; difference < separation; difference += 1) {
+        forbidden.add(label + difference);
+      }
+    };
+
+    neighbors[vertex].forEach((neighbor) => {
+      if (labels[neighbor]) {
+        forbid(labels[neighbor], h);
+      }
+
+      neighbors[neighbor].forEach((second) => {
+        if (second !== vertex && labels[second]) {
+          forbid(labels[second], k);
+        }
+      });
+    });
+
+    let label = 1;
+    while (forbidden.has(label)) {
+      label += 1;
+    }
+
+    labels[vertex] = label;
+    span = Math.max(span, label);
+  }
+
+  return span;
+}
+
+function toInputFile(graph) {
+  const lines = [`${graph.vertexCount} ${graph.edges.length} 0`];
+
+  graph.edges.forEach(([a, b]) => lines.push(`${a + 1} ${b + 1}`));
+
+  return `${lines.join('\n')}\n`;
+}
+
+module.exports = {
+  FAMILIES, greedySpan, toInputFile,
+};
+
+if (require.main === module) {
+  const [family, size, seed = '1'] = process.argv.slice(2);
+
+  if (!FAMILIES[family] || !size) {
+    console.log(`usage: node graphs.js family size [seed], families: ${Object.keys(FAMILIES).join(', ')}`);
+    process.exit(1);
+  }
+
+  process.stdout.write(toInputFile(FAMILIES[family].generate(parseInt(size, 10), parseInt(seed, 10))));
+}
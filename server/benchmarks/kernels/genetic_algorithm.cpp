@@ -0,0 +1,128 @@
+/*  Borsos Barna
+
+    Micro-benchmarks of the operators of the genetic algorithm, see
+    kernel_benchmark.h for the arguments. The operators are the ones of
+    GeneticAlgorithm.cpp, compiled here with its main() renamed.
+
+        selection              - tournament selection of a parent
+        crossover (operator)   - crossover with the evaluation of the offspring, for every operator
+        mutation               - mutation with the evaluation of the change
+        create_next_population - a whole generation of a population
+*/
+
+#define main genetic_algorithm_main
+#include "GeneticAlgorithm.cpp"
+#undef main
+
+#include <string>
+
+#include "kernel_benchmark.h"
+
+#define BENCHMARK_POPULATION_SIZE "60"
+
+void benchmark_genetic_algorithm(benchmark_case&, graph&);
+template<typename label_type> void benchmark_operators(benchmark_case&, parameters&, graph&, const char*, bool);
+
+int main(int argc, char** argv)
+{
+    return run_benchmarks(argc, argv, benchmark_genetic_algorithm);
+}
+
+void benchmark_genetic_algorithm(benchmark_case& benchmark, graph& graph)
+{
+    string max_label = to_string(benchmark.max_label);
+    const char* crossover_names[] = {"uniform", "block", "one-point", "two-point", "conflict"};
+
+    for(int i = 0; i < 5; ++i)
+    {
+        /* one population, every offspring mutates, the arguments of a run otherwise */
+        const char* arguments[] = {"GeneticAlgorithm", "2", "1", "-", max_label.c_str(), "1", BENCHMARK_POPULATION_SIZE,
+                                   "1", "2", "1", "1000", "--seed", "1", "--crossover", crossover_names[i]};
+
+        parameters parameters;
+        set_parameters(15, (char**) arguments, cout, parameters);
+
+        /* the other operators do not depend on the crossover operator, they are measured once */
+        if(parameters.max_label <= UINT8_MAX)
+        {
+            benchmark_operators<uint8_t>(benchmark, parameters, graph, crossover_names[i], i == 0);
+        }
+        else if(parameters.max_label <= UINT16_MAX)
+        {
+            benchmark_operators<uint16_t>(benchmark, parameters, graph, crossover_names[i], i == 0);
+        }
+        else
+        {
+            benchmark_operators<int>(benchmark, parameters, graph, crossover_names[i], i == 0);
+        }
+    }
+}
+
+template<typename label_type>
+void benchmark_operators(benchmark_case& benchmark, parameters& parameters, graph& graph,
+                         const char* crossover_name, bool all_operators)
+{
+    generation<label_type> g1;
+    generation<label_type> g2;
+    archipelago<label_type> archipelago;
+
+    initialize(parameters, graph, g1, g2);
+    initialize(parameters, graph, archipelago);
+
+    island& island = archipelago.islands[0];
+    population<label_type>& parents = g1.populations[0];
+    population<label_type>& offsprings = g2.populations[0];
+
+    /* the offsprings start as evaluated copies of the parents, they take the places after the elites in turn */
+    for(int i = 0; i < parameters.population_size; ++i)
+    {
+        copy_tracked_solution(parameters, graph, parents.chromosomes[i], offsprings.chromosomes[i]);
+    }
+
+    int offspring = parameters.elites;
+    int selected = 0;
+
+    if(all_operators)
+    {
+        run_kernel(benchmark, "selection", [&]
+        {
+            selected += selection(parameters, parents, island.generator);
+        });
+    }
+
+    string name = string("crossover (") + crossover_name + ")";
+
+    run_kernel(benchmark, name.c_str(), [&]
+    {
+        crossover(parameters, graph, archipelago, island,
+                  parents.chromosomes[random_int(island.generator, parameters.population_size)],
+                  parents.chromosomes[random_int(island.generator, parameters.population_size)],
+                  offsprings.chromosomes[offspring]);
+
+        offspring = offspring + 1 < parameters.population_size ? offspring + 1 : parameters.elites;
+    });
+
+    if(all_operators)
+    {
+        run_kernel(benchmark, "mutation", [&]
+        {
+            mutation(parameters, graph, offsprings.chromosomes[offspring], island.generator);
+            offspring = offspring + 1 < parameters.population_size ? offspring + 1 : parameters.elites;
+        });
+
+        run_kernel(benchmark, "create_next_population", [&]
+        {
+            /* every generation is the first one, the fitness history has a single entry */
+            island.generation_number = 0;
+            create_next_population(parameters, graph, g1, g2, archipelago, island);
+        });
+    }
+
+    /* keeps the selections from being optimized away */
+    if(selected < 0)
+    {
+        print_data(cout, parameters, graph, g1);
+    }
+
+    release(parameters, g1, g2, archipelago);
+}
@@ -0,0 +1,129 @@
+/*  Borsos Barna */
+
+#include "kernel_benchmark.h"
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <cstdlib>
+#include <atomic>
+#include <new>
+
+#include "labeling/random.h"
+
+using namespace std;
+
+static atomic<size_t> allocated(0);
+
+/* every allocation of the benchmarks and the labeling library is counted */
+void* operator new(size_t size)
+{
+    allocated += size;
+
+    void* memory = malloc(size ? size : 1);
+
+    if(!memory)
+    {
+        throw bad_alloc();
+    }
+
+    return memory;
+}
+
+void* operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void* memory) noexcept
+{
+    free(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+    free(memory);
+}
+
+size_t allocated_bytes()
+{
+    return allocated;
+}
+
+int run_benchmarks(int argc, char** argv, benchmark_function function)
+{
+    int vertex_counts[] = BENCHMARK_VERTEX_COUNTS;
+    int degrees[] = BENCHMARK_DEGREES;
+
+    int vertex_counts_size = sizeof(vertex_counts) / sizeof(int);
+    int degrees_size = sizeof(degrees) / sizeof(int);
+
+    /* a single case of the command line or every default case */
+    if(argc > 2)
+    {
+        vertex_counts[0] = atoi(argv[1]);
+        degrees[0] = atoi(argv[2]);
+        vertex_counts_size = degrees_size = 1;
+    }
+
+    int max_label = argc > 3 ? atoi(argv[3]) : BENCHMARK_MAX_LABEL;
+
+    if(vertex_counts[0] < 2 || degrees[0] < 1 || max_label < 1)
+    {
+        cout << "Error: check parameters!" << endl;
+        return 1;
+    }
+
+    cout << left << setw(28) << "kernel" << right << setw(10) << "vertexes" << setw(8) << "degree"
+         << setw(14) << "ns/op" << setw(14) << "bytes/op" << endl;
+
+    for(int i = 0; i < vertex_counts_size; ++i)
+    {
+        for(int j = 0; j < degrees_size; ++j)
+        {
+            benchmark_case benchmark;
+            benchmark.vertex_count = vertex_counts[i];
+            benchmark.degree = degrees[j];
+            benchmark.max_label = max_label;
+
+            graph graph;
+            random_graph(benchmark, graph);
+
+            function(benchmark, graph);
+
+            free_graph(graph);
+        }
+    }
+
+    return 0;
+}
+
+void random_graph(benchmark_case& benchmark, graph& graph)
+{
+    random_generator generator;
+    seed_generator(generator, BENCHMARK_SEED, 0);
+
+    /* G(n, m) graph in the input file format, read the way the algorithms read their files */
+    int edge_count = (int) ((int64_t) benchmark.vertex_count * benchmark.degree / 2);
+    stringstream input;
+
+    input << benchmark.vertex_count << ' ' << edge_count << " 0\n";
+
+    for(int i = 0; i < edge_count; ++i)
+    {
+        int a = random_int(generator, benchmark.vertex_count);
+        int b = random_int(generator, benchmark.vertex_count - 1);
+
+        /* no loops, b is any other vertex */
+        input << a + 1 << ' ' << (b >= a ? b + 1 : b) + 1 << '\n';
+    }
+
+    read_graph(input, graph);
+}
+
+void print_result(benchmark_case& benchmark, const char* name, double time, int64_t operations, size_t bytes)
+{
+    cout << left << setw(28) << name << right << setw(10) << benchmark.vertex_count << setw(8) << benchmark.degree
+         << fixed << setprecision(1) << setw(14) << time * 1e9 / operations
+         << setw(14) << (double) bytes / operations << endl;
+}
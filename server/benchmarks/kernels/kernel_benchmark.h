@@ -0,0 +1,79 @@
+/*  Borsos Barna
+
+    Micro-benchmarks of the kernels of the algorithms.
+
+    Every benchmark executable takes the same arguments and measures its
+    kernels on random graphs, G(n, m) graphs of the given vertex count
+    and average degree, generated from a fixed seed:
+
+        argv[1] - vertex count (default: every size of BENCHMARK_VERTEX_COUNTS)
+        argv[2] - average degree (default: every degree of BENCHMARK_DEGREES)
+        argv[3] - max. label value (default: BENCHMARK_MAX_LABEL)
+
+    A kernel is run again and again for BENCHMARK_TIME seconds, the report
+    gives its average time and the bytes it allocated with new and new[]
+    per operation (counted by the replaced global operator new).
+*/
+
+#ifndef KERNEL_BENCHMARK_H
+#define KERNEL_BENCHMARK_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "labeling/graph.h"
+#include "labeling/timer.h"
+
+#define BENCHMARK_TIME 0.2          // running time of a kernel (seconds)
+#define BENCHMARK_BATCHES 100       // min. readings of the clock during a kernel
+#define BENCHMARK_MAX_LABEL 100     // default max. label, the labels fit in a byte
+#define BENCHMARK_SEED 1            // seed of the graphs and the solutions
+
+#define BENCHMARK_VERTEX_COUNTS {1000, 10000, 100000}
+#define BENCHMARK_DEGREES {4, 16}
+
+struct benchmark_case
+{
+    int vertex_count;               // vertexes of the random graph
+    int degree;                     // average degree of the random graph
+    int max_label;                  // max. label of the solutions
+};
+
+typedef void (*benchmark_function)(benchmark_case&, graph&);
+
+int run_benchmarks(int, char**, benchmark_function);
+void random_graph(benchmark_case&, graph&);
+size_t allocated_bytes();
+void print_result(benchmark_case&, const char*, double, int64_t, size_t);
+
+/* runs the kernel until the benchmark time is over and prints its time and allocations per operation */
+template<typename kernel_type>
+void run_kernel(benchmark_case& benchmark, const char* name, kernel_type kernel)
+{
+    double start_time = current_time();
+    size_t start_bytes = allocated_bytes();
+    int64_t operations = 0;
+    int64_t batch = 1;
+
+    /* the batches grow until the clock is read rarely compared to the kernel */
+    while(elapsed_time(start_time) < BENCHMARK_TIME)
+    {
+        double batch_start = current_time();
+
+        for(int64_t i = 0; i < batch; ++i)
+        {
+            kernel();
+        }
+
+        operations += batch;
+
+        if(elapsed_time(batch_start) < BENCHMARK_TIME / BENCHMARK_BATCHES)
+        {
+            batch *= 2;
+        }
+    }
+
+    print_result(benchmark, name, elapsed_time(start_time), operations, allocated_bytes() - start_bytes);
+}
+
+#endif
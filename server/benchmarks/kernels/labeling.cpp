@@ -0,0 +1,126 @@
+/*  Borsos Barna
+
+    Micro-benchmarks of the graph and the evaluation kernels of the
+    labeling library, see kernel_benchmark.h for the arguments.
+
+        read_graph             - parsing the input file and building the graph
+        constraint_vertexes    - building the constraint vertex lists
+        is_conflicting_vertex  - checking the constraints of one vertex
+        evaluate               - full evaluation (correctness, conflicts, fitness)
+        relabel                - changing a label with the tracked evaluation
+*/
+
+#include <iostream>
+#include <sstream>
+
+#include "kernel_benchmark.h"
+#include "labeling/graph.h"
+#include "labeling/solution.h"
+#include "labeling/evaluator.h"
+#include "labeling/random.h"
+
+using namespace std;
+
+void benchmark_labeling(benchmark_case&, graph&);
+template<typename label_type> void benchmark_evaluation(benchmark_case&, constraints&, graph&);
+
+int main(int argc, char** argv)
+{
+    return run_benchmarks(argc, argv, benchmark_labeling);
+}
+
+void benchmark_labeling(benchmark_case& benchmark, graph& graph)
+{
+    /* the input file of the graph again without the repeated edges, parsed from memory */
+    stringstream file;
+    file << graph.vertex_count << ' ' << graph.neighbor_offsets[graph.vertex_count] / 2 << " 0\n";
+
+    for(int i = 0; i < graph.vertex_count; ++i)
+    {
+        for(int j = graph.neighbor_offsets[i]; j < graph.neighbor_offsets[i + 1]; ++j)
+        {
+            if(i < graph.neighbors[j])
+            {
+                file << i + 1 << ' ' << graph.neighbors[j] + 1 << '\n';
+            }
+        }
+    }
+
+    string input = file.str();
+
+    run_kernel(benchmark, "read_graph", [&]
+    {
+        istringstream stream(input);
+        struct graph parsed;
+
+        read_graph(stream, parsed);
+        free_graph(parsed);
+    });
+
+    run_kernel(benchmark, "constraint_vertexes", [&]
+    {
+        delete[] graph.constraint_offsets;
+        delete[] graph.constraint_vertexes;
+
+        constraint_vertexes(graph);
+    });
+
+    constraints constraints;
+    constraints.h = 2;
+    constraints.k = 1;
+    constraints.max_label = benchmark.max_label;
+
+    /* the labels in the narrowest type holding max. label, as the algorithms store them */
+    if(constraints.max_label <= UINT8_MAX)
+    {
+        benchmark_evaluation<uint8_t>(benchmark, constraints, graph);
+    }
+    else if(constraints.max_label <= UINT16_MAX)
+    {
+        benchmark_evaluation<uint16_t>(benchmark, constraints, graph);
+    }
+    else
+    {
+        benchmark_evaluation<int>(benchmark, constraints, graph);
+    }
+}
+
+template<typename label_type>
+void benchmark_evaluation(benchmark_case& benchmark, constraints& constraints, graph& graph)
+{
+    random_generator generator;
+    seed_generator(generator, BENCHMARK_SEED, 0);
+
+    solution<label_type> solution;
+    allocate_solution(constraints, graph, solution, true);
+    random_solution(constraints, graph, solution, generator);
+    evaluate(constraints, graph, solution);
+
+    int vertex = 0;
+    int conflicting = 0;
+
+    run_kernel(benchmark, "is_conflicting_vertex", [&]
+    {
+        conflicting += is_conflicting_vertex(constraints, graph, solution, vertex);
+        vertex = vertex + 1 < graph.vertex_count ? vertex + 1 : 0;
+    });
+
+    run_kernel(benchmark, "evaluate", [&]
+    {
+        evaluate(constraints, graph, solution);
+    });
+
+    run_kernel(benchmark, "relabel", [&]
+    {
+        relabel(constraints, graph, solution, random_int(generator, graph.vertex_count),
+                random_int(generator, constraints.max_label) + 1);
+    });
+
+    /* keeps the checks from being optimized away */
+    if(conflicting < 0)
+    {
+        print_solution(cout, graph, solution);
+    }
+
+    free_solution(solution);
+}
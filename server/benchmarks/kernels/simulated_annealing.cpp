@@ -0,0 +1,76 @@
+/*  Borsos Barna
+
+    Micro-benchmarks of the moves of the simulated annealing, see
+    kernel_benchmark.h for the arguments. The moves are the ones of
+    SimulatedAnnealing.cpp, compiled here with its main() renamed.
+
+        generate_next_solution - proposing a move with the evaluation of the change
+        iterate                - a whole iteration (move, acceptance or undo, best solution, cooling)
+*/
+
+#define main simulated_annealing_main
+#include "SimulatedAnnealing.cpp"
+#undef main
+
+#include <string>
+
+#include "kernel_benchmark.h"
+
+void benchmark_simulated_annealing(benchmark_case&, graph&);
+template<typename label_type> void benchmark_moves(benchmark_case&, parameters&, graph&);
+
+int main(int argc, char** argv)
+{
+    return run_benchmarks(argc, argv, benchmark_simulated_annealing);
+}
+
+void benchmark_simulated_annealing(benchmark_case& benchmark, graph& graph)
+{
+    string max_label = to_string(benchmark.max_label);
+
+    /* a single chain with the arguments of a run */
+    const char* arguments[] = {"SimulatedAnnealing", "2", "1", "-", max_label.c_str(), "1", "0.9999",
+                               "1000000000", "1000", "--seed", "1"};
+
+    parameters parameters;
+    set_parameters(11, (char**) arguments, cout, parameters);
+
+    if(parameters.max_label <= UINT8_MAX)
+    {
+        benchmark_moves<uint8_t>(benchmark, parameters, graph);
+    }
+    else if(parameters.max_label <= UINT16_MAX)
+    {
+        benchmark_moves<uint16_t>(benchmark, parameters, graph);
+    }
+    else
+    {
+        benchmark_moves<int>(benchmark, parameters, graph);
+    }
+}
+
+template<typename label_type>
+void benchmark_moves(benchmark_case& benchmark, parameters& parameters, graph& graph)
+{
+    state<label_type> state;
+    seed_generator(state.generator, parameters.seed, 0);
+    initialize(parameters, graph, state);
+
+    /* every proposed move is kept, the solution walks randomly */
+    run_kernel(benchmark, "generate_next_solution", [&]
+    {
+        generate_next_solution(parameters, graph, state);
+    });
+
+    /* the best solution is the current one again */
+    copy_evaluation(state.current_solution, state.best_solution);
+    state.best_is_current = true;
+
+    run_kernel(benchmark, "iterate", [&]
+    {
+        iterate(parameters, graph, state);
+    });
+
+    free_solution(state.current_solution);
+    free_solution(state.best_solution);
+}
@@ -0,0 +1,173 @@
+/* Benchmark suite of the solvers on the graph families of graphs.js. Every solver runs on every
+   instance with fixed seeds, twice: once stopped at the first correct solution for the time to
+   first feasible, and once for the whole running time for the throughput and the final span.
+
+   The max. label of an instance is the span of a first fit labeling (see graphs.js), the final
+   span is the chromatic number of the correct solutions minus one, as the labels start at 1.
+
+   node server/benchmarks/suite.js [maxTime] [runs] [sizes] [resultFile]
+
+   sizes is a comma separated list of small, medium and large (default: small,medium), the rows
+   are also written to resultFile as JSON, so two builds can be compared.
+*/
+
+const fs = require('fs');
+const os = require('os');
+const path = require('path');
+const { spawnSync } = require('child_process');
+const { FAMILIES, greedySpan, toInputFile } = require('./graphs');
+
+const H = 2;
+const K = 1;
+const GRAPH_SEED = 1;
+const MAX_ITERATIONS = 1000000000;
+const MAX_GENERATIONS = 1000000;     // the genetic algorithm keeps the fitness of every generation
+const SIZES = ['small', 'medium', 'large'];
+
+/* the solution line of the output, the correctness, the conflicting vertexes and the
+   chromatic number follow it */
+const SOLVERS = [
+  {
+    name: 'SA',
+    executable: 'SimulatedAnnealing',
+    unit: 'moves/s',
+    solutionLine: 3,
+    args: (file, maxLabel, maxTime) => [H, K, file, maxLabel, 1, 0.9999, MAX_ITERATIONS, maxTime],
+  },
+  {
+    name: 'GA',
+    executable: 'GeneticAlgorithm',
+    unit: 'gen/s',
+    solutionLine: 2,
+    args: (file, maxLabel, maxTime) => [H, K, file, maxLabel, 2, 60, 0.5, 2, MAX_GENERATIONS, maxTime],
+  },
+  {
+    name: 'TS',
+    executable: 'TabuSearch',
+    unit: 'moves/s',
+    solutionLine: 3,
+    args: (file, maxLabel, maxTime) => [H, K, file, maxLabel, 10, MAX_ITERATIONS, maxTime],
+  },
+];
+
+const [maxTime = '1', runs = '2', sizes = 'small,medium', resultFile] = process.argv.slice(2);
+const directory = path.join(os.tmpdir(), 'graph-labeling-benchmarks');
+
+/* write the instances of the asked sizes, the generated graphs are the same on every run */
+function createInstances() {
+  const instances = [];
+
+  fs.mkdirSync(directory, { recursive: true });
+
+  Object.keys(FAMILIES).forEach((family) => {
+    FAMILIES[family].sizes.forEach((size, index) => {
+      if (!sizes.split(',').includes(SIZES[index])) {
+        return;
+      }
+
+      const graph = FAMILIES[family].generate(size, GRAPH_SEED);
+      const file = path.join(directory, `${family}-${size}.in`);
+
+      fs.writeFileSync(file, toInputFile(graph));
+
+      instances.push({
+        name: `${family}-${size}`,
+        file,
+        vertexCount: graph.vertexCount,
+        edgeCount: graph.edges.length,
+        maxLabel: greedySpan(graph, H, K),
+      });
+    });
+  });
+
+  return instances;
+}
+
+function runSolver(solver, instance, seed, stopFeasible) {
+  const args = solver.args(instance.file, instance.maxLabel, maxTime).concat(['--seed', seed]);
+
+  if (stopFeasible) {
+    args.push('--stop-feasible', 1);
+  }
+
+  const result = spawnSync(path.join(__dirname, '..', 'bin', solver.executable), args.map(String), { encoding: 'utf8' });
+  const lines = result.stdout.split('\n');
+
+  if (result.status !== 0) {
+    throw new Error(`${solver.name} ${instance.name}: ${lines[0]}`);
+  }
+
+  /* time elapsed, iterations (generations) done, correctness and chromatic number of the output */
+  return {
+    time: parseFloat(lines[0]),
+    iterations: parseInt(lines[1], 10),
+    feasible: lines[solver.solutionLine + 1] === '1',
+    span: parseInt(lines[solver.solutionLine + 3], 10) - 1,
+  };
+}
+
+function average(values) {
+  return values.length ? values.reduce((sum, value) => sum + value, 0) / values.length : null;
+}
+
+function format(value, digits) {
+  return value === null ? '-' : value.toFixed(digits);
+}
+
+if (!sizes.split(',').every(size => SIZES.includes(size))) {
+  console.log('usage: node suite.js [maxTime] [runs] [sizes] [resultFile]');
+  process.exit(1);
+}
+
+const rows = [];
+
+console.log([
+  'instance'.padEnd(26), 'V'.padStart(6), 'E'.padStart(6), 'max. label', 'solver', 'feasible',
+  'first feasible (s)', 'span', 'throughput'.padStart(18),
+].join('  '));
+
+createInstances().forEach((instance) => {
+  SOLVERS.forEach((solver) => {
+    const firstFeasible = [];
+    const finals = [];
+
+    for (let seed = 1; seed <= parseInt(runs, 10); seed += 1) {
+      firstFeasible.push(runSolver(solver, instance, seed, true));
+      finals.push(runSolver(solver, instance, seed, false));
+    }
+
+    /* the time to first feasible and the span count the feasible runs only */
+    const feasible = firstFeasible.filter(result => result.feasible);
+    const row = {
+      instance: instance.name,
+      vertexCount: instance.vertexCount,
+      edgeCount: instance.edgeCount,
+      maxLabel: instance.maxLabel,
+      solver: solver.name,
+      feasible: feasible.length,
+      runs: firstFeasible.length,
+      firstFeasibleTime: average(feasible.map(result => result.time)),
+      span: average(finals.filter(result => result.feasible).map(result => result.span)),
+      throughput: average(finals.map(result => result.iterations / result.time)),
+      unit: solver.unit,
+    };
+
+    rows.push(row);
+
+    console.log([
+      row.instance.padEnd(26),
+      String(row.vertexCount).padStart(6),
+      String(row.edgeCount).padStart(6),
+      String(row.maxLabel).padStart(10),
+      row.solver.padStart(6),
+      `${row.feasible}/${row.runs}`.padStart(8),
+      format(row.firstFeasibleTime, 4).padStart(18),
+      format(row.span, 1).padStart(4),
+      `${format(row.throughput, 0)} ${row.unit}`.padStart(18),
+    ].join('  '));
+  });
+});
+
+if (resultFile) {
+  fs.writeFileSync(resultFile, JSON.stringify(rows, null, 2));
+}
@@ -1,91 +1,7 @@
-const fs = require('fs');
-const path = require('path');
-const { execFile } = require('child_process');
+const { runSolver, responder } = require('../solvers');
 
 const MAX_RUNNING_TIME = 60; /* (seconds) */
 
-function checkFileContent(fileContent, maxLabel) {
-  /* split by unix line ending convention */
-  const lines = fileContent.replace(/\r/g, '').split('\n');
-
-  /* check first line */
-  let numbers = lines[0].split(' ');
-
-  if (numbers.length !== 3) {
-    return 1;
-  }
-
-  const vertexCount = Number(numbers[0]);
-  const edgeCount = Number(numbers[1]);
-  const fixedVertexes = Number(numbers[2]);
-
-  if (Number.isInteger(vertexCount) === false ||
-      Number.isInteger(edgeCount) === false ||
-      Number.isInteger(fixedVertexes) === false) {
-    return 1;
-  }
-
-  if (vertexCount < 1 || edgeCount < 0 || fixedVertexes < 0) {
-    return 1;
-  }
-
-  /* check every edge */
-  let lineIndex = 1;
-
-  for (lineIndex; lineIndex <= edgeCount; lineIndex += 1) {
-    if (lineIndex >= lines.length) {
-      return lineIndex + 1;
-    }
-    numbers = lines[lineIndex].split(' ');
-
-    if (numbers.length !== 2) {
-      return lineIndex + 1;
-    }
-
-    const vertex1 = Number(numbers[0]);
-    const vertex2 = Number(numbers[1]);
-
-    if (Number.isInteger(vertex1) === false ||
-        Number.isInteger(vertex2) === false) {
-      return lineIndex + 1;
-    }
-
-    if (vertex1 < 1 || vertex1 > vertexCount ||
-        vertex2 < 1 || vertex2 > vertexCount) {
-      return lineIndex + 1;
-    }
-  }
-
-  /* check fixed vertexes */
-  const lastLineIndex = edgeCount + fixedVertexes;
-
-  for (lineIndex; lineIndex <= lastLineIndex; lineIndex += 1) {
-    if (lineIndex >= lines.length) {
-      return lineIndex + 1;
-    }
-    numbers = lines[lineIndex].split(' ');
-
-    if (numbers.length !== 2) {
-      return lineIndex + 1;
-    }
-
-    const vertex = Number(numbers[0]);
-    const label = Number(numbers[1]);
-
-    if (Number.isInteger(vertex) === false ||
-        Number.isInteger(label) === false) {
-      return lineIndex + 1;
-    }
-
-    if (vertex < 1 || vertex > vertexCount ||
-        label < 1 || label > maxLabel) {
-      return lineIndex + 1;
-    }
-  }
-
-  return null;
-}
-
 function validateParameters(req) {
   /* extract parameters */
   const h = req.body.h;
@@ -114,15 +30,16 @@ function validateParameters(req) {
   }
 
   /* check parameters type */
-  if (Number.isInteger(Number(h)) === false ||
+  if (typeof fileContent !== 'string' ||
+      Number.isInteger(Number(h)) === false ||
       Number.isInteger(Number(k)) === false ||
       Number.isInteger(Number(maxLabel)) === false ||
       Number.isInteger(Number(populationsCount)) === false ||
       Number.isInteger(Number(populationSize)) === false ||
-      isNaN(Number(mutationChance)) ||
+      Number.isFinite(Number(mutationChance)) === false ||
       Number.isInteger(Number(elitesCount)) === false ||
       Number.isInteger(Number(maxGenerations)) === false ||
-      Number.isInteger(Number(maxTime)) === false) {
+      Number.isFinite(Number(maxTime)) === false) {
     return 'Please verify parameter types!';
   }
 
@@ -137,18 +54,12 @@ function validateParameters(req) {
       elitesCount < 0 ||
       elitesCount > populationSize ||
       maxGenerations < 1 ||
-      maxTime < 1 ||
+      maxTime <= 0 ||
       maxTime > MAX_RUNNING_TIME) {
     return 'Please double check parameter values!';
   }
 
-  /* check input file */
-  const errorLine = checkFileContent(fileContent, maxLabel);
-
-  if (errorLine) {
-    return `Invalid input file format! (Line: ${errorLine})`;
-  }
-
+  /* the input file is checked by the solver, which reports the line of the error */
   return null;
 }
 
@@ -174,24 +85,30 @@ module.exports = (req, res) => {
   const maxGenerations = req.body.maxGenerations;
   const maxTime = req.body.maxTime;
 
-  /* path of the executable file */
-  const execPath = path.join(__dirname, '..', 'bin', 'GeneticAlgorithm');
+  /* run the job on the solver daemon, with progress records if asked for */
+  const args = [h, k, '-', maxLabel, populationsCount, populationSize, mutationChance, elitesCount,
+    maxGenerations, maxTime];
+  const { respond, onProgress } = responder(res, req.body.progress === true);
 
-  /* create input file */
-  const suffix = Math.floor((Math.random() * 1e6));
-  const filePath = path.join(__dirname, '..', 'tmp', `${suffix}.in`);
+  if (onProgress) {
+    args.push('--progress', 1);
+  }
 
-  fs.writeFileSync(filePath, fileContent);
+  /* the statistics of the run follow the output, see server/algorithms/labeling/stats.h */
+  const stats = req.body.stats === true;
 
-  // call exec
-  execFile(execPath,
-    [h, k, filePath, maxLabel, populationsCount, populationSize, mutationChance, elitesCount,
-      maxGenerations, maxTime],
-    (error, stdout, stderr) => {
+  if (stats) {
+    args.push('--stats', 1);
+  }
+
+  const cancel = runSolver('GeneticAlgorithm', args, fileContent,
+    (error, stdout) => {
     /* check for any error */
-      if (error || stderr) {
-        res.json(error);
-        // res.json({ errorMsg: 'Something went wrong!' });
+      if (error && error.inputLine) {
+        respond({ errorMsg: `Invalid input file format! (Line: ${error.inputLine})` });
+      } else if (error) {
+        respond(error);
+        // respond({ errorMsg: 'Something went wrong!' });
       } else {
         const lines = stdout.toString().replace(/\r/g, '').split('\n');
 
@@ -206,12 +123,29 @@ module.exports = (req, res) => {
         responseJSON.chromaticNumber = parseInt(lines[5], 10);
         responseJSON.fitness = parseFloat(lines[6], 10);
         responseJSON.history = lines[7];
+
+        if (stats) {
+          /* an unreadable statistics line fails the request, not the server */
+          try {
+            responseJSON.stats = JSON.parse(lines[8]);
+          } catch (parseError) {
+            respond({ errorMsg: 'Something went wrong!' });
+
+            return;
+          }
+        }
+
         responseJSON.errorMsg = null;
 
-        res.json(responseJSON);
+        respond(responseJSON);
       }
+    },
+    onProgress);
 
-      // delete input file
-      fs.unlink(filePath, () => {});
-    });
+  /* a client leaving before the result cancels the job, the solver stops early */
+  res.on('close', () => {
+    if (!res.writableEnded) {
+      cancel();
+    }
+  });
 };
@@ -0,0 +1,132 @@
+const { runSolver, responder } = require('../solvers');
+
+const MAX_RUNNING_TIME = 60; /* (seconds) */
+
+function validateParameters(req) {
+  /* extract parameters */
+  const h = req.body.h;
+  const k = req.body.k;
+  const fileContent = req.body.fileContent;
+  const maxLabel = req.body.maxLabel;
+  const tabuTenure = req.body.tabuTenure;
+  const maxIterations = req.body.maxIterations;
+  const maxTime = req.body.maxTime;
+
+  /* check parameters existance */
+  if (h == null ||
+      k == null ||
+      fileContent == null ||
+      maxLabel == null ||
+      tabuTenure == null ||
+      maxIterations == null ||
+      maxTime == null) {
+    return 'Please provide all parameters!';
+  }
+
+  /* check parameters type */
+  if (typeof fileContent !== 'string' ||
+      Number.isInteger(Number(h)) === false ||
+      Number.isInteger(Number(k)) === false ||
+      Number.isInteger(Number(maxLabel)) === false ||
+      Number.isInteger(Number(tabuTenure)) === false ||
+      Number.isInteger(Number(maxIterations)) === false ||
+      Number.isFinite(Number(maxTime)) === false) {
+    return 'Please verify parameter types!';
+  }
+
+  /* check parameters value */
+  if (h < 0 ||
+      k < 0 ||
+      maxLabel < 1 ||
+      tabuTenure < 0 ||
+      maxIterations < 1 ||
+      maxTime <= 0 ||
+      maxTime > MAX_RUNNING_TIME) {
+    return 'Please double check parameter values!';
+  }
+
+  /* the input file is checked by the solver, which reports the line of the error */
+  return null;
+}
+
+module.exports = (req, res) => {
+  /* validate request parameters */
+  const errorMsg = validateParameters(req);
+
+  if (errorMsg) {
+    res.json({ errorMsg });
+
+    return;
+  }
+
+  /* set parameters */
+  const h = req.body.h;
+  const k = req.body.k;
+  const fileContent = req.body.fileContent;
+  const maxLabel = req.body.maxLabel;
+  const tabuTenure = req.body.tabuTenure;
+  const maxIterations = req.body.maxIterations;
+  const maxTime = req.body.maxTime;
+
+  /* run the job on the solver daemon, with progress records if asked for */
+  const args = [h, k, '-', maxLabel, tabuTenure, maxIterations, maxTime];
+  const { respond, onProgress } = responder(res, req.body.progress === true);
+
+  if (onProgress) {
+    args.push('--progress', 1);
+  }
+
+  /* the statistics of the run follow the output, see server/algorithms/labeling/stats.h */
+  const stats = req.body.stats === true;
+
+  if (stats) {
+    args.push('--stats', 1);
+  }
+
+  const cancel = runSolver('TabuSearch', args, fileContent,
+    (error, stdout) => {
+    /* check for any error */
+      if (error && error.inputLine) {
+        respond({ errorMsg: `Invalid input file format! (Line: ${error.inputLine})` });
+      } else if (error) {
+        respond({ errorMsg: 'Something went wrong!' });
+      } else {
+        const lines = stdout.toString().replace(/\r/g, '').split('\n');
+
+        /* create the JSON object to be returned */
+        const responseJSON = {};
+
+        responseJSON.time = parseFloat(lines[0], 10);
+        responseJSON.iterations = parseInt(lines[1], 10);
+        responseJSON.bestIteration = parseInt(lines[2], 10);
+        responseJSON.solution = lines[3].trim();
+        responseJSON.isCorrect = lines[4] === '1';
+        responseJSON.conflictingVertexes = parseInt(lines[5], 10);
+        responseJSON.chromaticNumber = parseInt(lines[6], 10);
+        responseJSON.fitness = parseFloat(lines[7], 10);
+
+        if (stats) {
+          /* an unreadable statistics line fails the request, not the server */
+          try {
+            responseJSON.stats = JSON.parse(lines[8]);
+          } catch (parseError) {
+            respond({ errorMsg: 'Something went wrong!' });
+
+            return;
+          }
+        }
+
+        responseJSON.errorMsg = null;
+
+        respond(responseJSON);
+      }
+    },
+    onProgress);
+
+  /* a client leaving before the result cancels the job, the solver stops early */
+  res.on('close', () => {
+    if (!res.writableEnded) {
+      cancel();
+    }
+  });
+};
@@ -5,9 +5,11 @@ const router = express.Router();
 /* Require Controller Modules */
 const SAController = require('./controllers/SAController');
 const GAController = require('./controllers/GAController');
+const TSController = require('./controllers/TSController');
 
 /* Define API endpoints */
 router.post('/SA', SAController);
 router.post('/GA', GAController);
+router.post('/TS', TSController);
 
 module.exports = router;
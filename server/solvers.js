@@ -0,0 +1,141 @@
+const path = require('path');
+const { spawn } = require('child_process');
+
+/* one long-running daemon for every solver executable */
+const daemons = {};
+let nextJobId = 1;
+
+function readResults(daemon) {
+  /* a result is a header line (job id, exit status, line count) and the output lines,
+     progress records come the same way with "progress" in place of the exit status */
+  for (;;) {
+    const headerEnd = daemon.buffer.indexOf('\n');
+
+    if (headerEnd < 0) {
+      return;
+    }
+
+    const header = daemon.buffer.slice(0, headerEnd).split(' ');
+    const lineCount = parseInt(header[2], 10);
+    let outputEnd = headerEnd;
+
+    for (let i = 0; i < lineCount; i += 1) {
+      outputEnd = daemon.buffer.indexOf('\n', outputEnd + 1);
+
+      if (outputEnd < 0) {
+        return;
+      }
+    }
+
+    const output = daemon.buffer.slice(headerEnd + 1, outputEnd + 1);
+    const job = daemon.jobs.get(header[0]);
+
+    daemon.buffer = daemon.buffer.slice(outputEnd + 1);
+
+    if (header[1] === 'progress') {
+      if (job && job.onProgress) {
+        /* a record that is not JSON is dropped, it must not throw in the stdout handler */
+        output.split('\n').filter(line => line).forEach((line) => {
+          let record;
+
+          try {
+            record = JSON.parse(line);
+          } catch (error) {
+            return;
+          }
+
+          job.onProgress(record);
+        });
+      }
+    } else if (job) {
+      const { callback } = job;
+
+      daemon.jobs.delete(header[0]);
+
+      if (header[1] === '0') {
+        callback(null, output);
+      } else {
+        const error = new Error(output.trim());
+        const inputLine = /invalid input file \(line (\d+)\)/.exec(output);
+
+        /* line of the input file the solver rejected */
+        error.inputLine = inputLine ? parseInt(inputLine[1], 10) : null;
+        callback(error, output);
+      }
+    }
+  }
+}
+
+function startDaemon(executable) {
+  const daemon = {
+    process: spawn(path.join(__dirname, 'bin', executable), ['--daemon']),
+    buffer: '',
+    jobs: new Map(),
+  };
+
+  daemon.process.stdout.setEncoding('utf8');
+  daemon.process.stdout.on('data', (chunk) => {
+    daemon.buffer += chunk;
+    readResults(daemon);
+  });
+
+  /* fail the pending jobs, the next job starts a new daemon */
+  const stop = (error) => {
+    if (daemons[executable] === daemon) {
+      delete daemons[executable];
+    }
+
+    daemon.jobs.forEach(job => job.callback(error || new Error(`${executable} exited`), ''));
+    daemon.jobs.clear();
+  };
+
+  daemon.process.on('error', stop);
+  daemon.process.on('exit', () => stop());
+  daemon.process.stdin.on('error', () => {});
+
+  return daemon;
+}
+
+/* runs a solver on a graph with the command line arguments ("-" as file path),
+   callback(error, stdout) receives the output of the command line mode,
+   onProgress(record) the progress records of a job run with "--progress 1";
+   returns a function cancelling the job, its callback then gets the best solution so far */
+function runSolver(executable, args, fileContent, callback, onProgress) {
+  if (!daemons[executable]) {
+    daemons[executable] = startDaemon(executable);
+  }
+
+  const daemon = daemons[executable];
+  const jobId = String(nextJobId);
+  nextJobId += 1;
+
+  daemon.jobs.set(jobId, { callback, onProgress });
+
+  const jobArgs = args.map(arg => String(arg).trim());
+
+  daemon.process.stdin.write(`${jobId} ${Buffer.byteLength(fileContent)}\n${jobArgs.join(' ')}\n`);
+  daemon.process.stdin.write(fileContent);
+
+  return () => {
+    if (daemon.jobs.has(jobId)) {
+      daemon.process.stdin.write(`${jobId} cancel\n`);
+    }
+  };
+}
+
+/* with progress the response is newline delimited JSON: the progress records of the job
+   as they arrive, then the result. respond(json) sends the result, onProgress the records */
+function responder(res, progress) {
+  if (!progress) {
+    return { respond: json => res.json(json), onProgress: undefined };
+  }
+
+  res.type('application/x-ndjson');
+
+  return {
+    respond: json => res.end(`${JSON.stringify(json)}\n`),
+    onProgress: record => res.write(`${JSON.stringify(Object.assign(record, { errorMsg: null }))}\n`),
+  };
+}
+
+module.exports = { runSolver, responder };
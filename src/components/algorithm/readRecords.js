@@ -0,0 +1,23 @@
+/* read a newline delimited JSON response, record by record; the promise is rejected
+   on a network error or a line which is not JSON, the rest of the response is dropped then */
+export default function readRecords(res, onRecord) {
+  const reader = res.body.getReader();
+  const decoder = new TextDecoder();
+  let buffer = '';
+
+  const read = () => reader.read().then(({ done, value }) => {
+    buffer += decoder.decode(value || new Uint8Array(0), { stream: !done });
+
+    const lines = buffer.split('\n');
+    buffer = done ? '' : lines.pop();
+
+    lines.filter(line => line.trim()).forEach(line => onRecord(JSON.parse(line)));
+
+    return done ? null : read();
+  });
+
+  return read().catch((error) => {
+    reader.cancel().catch(() => {});
+    throw error;
+  });
+}